@@ -1,457 +1,4362 @@
-// Distributed under the Boost Software License, Version 1.0. (See
-// accompanying file LICENSE_1_0.txt or copy at
-// http://www.boost.org/LICENSE_1_0.txt)
-// (C) Copyright 2007 Anthony Williams
-#include "fixed.hpp"
-
-__int64 const internal_pi=0x3243f6a8;
-__int64 const internal_two_pi=0x6487ed51;
-__int64 const internal_half_pi=0x1921fb54;
-__int64 const internal_quarter_pi=0xc90fdaa;
-
-extern fixed const fixed_pi(fixed::internal(),internal_pi);
-extern fixed const fixed_two_pi(fixed::internal(),internal_two_pi);
-extern fixed const fixed_half_pi(fixed::internal(),internal_half_pi);
-extern fixed const fixed_quarter_pi(fixed::internal(),internal_quarter_pi);
-
-fixed& fixed::operator%=(fixed const& other)
-{
-    m_nVal = m_nVal%other.m_nVal;
-    return *this;
-}
-
-fixed& fixed::operator*=(fixed const& val)
-{
-    bool const val_negative=val.m_nVal<0;
-    bool const this_negative=m_nVal<0;
-    bool const negate=val_negative ^ this_negative;
-    unsigned __int64 const other=val_negative?-val.m_nVal:val.m_nVal;
-    unsigned __int64 const self=this_negative?-m_nVal:m_nVal;
-    
-    if(unsigned __int64 const self_upper=(self>>32))
-    {
-        m_nVal=(self_upper*other)<<(32-fixed_resolution_shift);
-    }
-    else
-    {
-        m_nVal=0;
-    }
-    if(unsigned __int64 const self_lower=(self&0xffffffff))
-    {
-        unsigned long const other_upper=static_cast<unsigned long>(other>>32);
-        unsigned long const other_lower=static_cast<unsigned long>(other&0xffffffff);
-        unsigned __int64 const lower_self_upper_other_res=self_lower*other_upper;
-        unsigned __int64 const lower_self_lower_other_res=self_lower*other_lower;
-        m_nVal+=(lower_self_upper_other_res<<(32-fixed_resolution_shift))
-            + (lower_self_lower_other_res>>fixed_resolution_shift);
-    }
-    
-    if(negate)
-    {
-        m_nVal=-m_nVal;
-    }
-    return *this;
-}
-
-
-fixed& fixed::operator/=(fixed const& divisor)
-{
-    if( !divisor.m_nVal)
-    {
-        m_nVal=fixed_max.m_nVal;
-    }
-    else
-    {
-        bool const negate_this=(m_nVal<0);
-        bool const negate_divisor=(divisor.m_nVal<0);
-        bool const negate=negate_this ^ negate_divisor;
-        unsigned __int64 a=negate_this?-m_nVal:m_nVal;
-        unsigned __int64 b=negate_divisor?-divisor.m_nVal:divisor.m_nVal;
-
-        unsigned __int64 res=0;
-    
-        unsigned __int64 temp=b;
-        bool const a_large=a>b;
-        unsigned shift=fixed_resolution_shift;
-
-        if(a_large)
-        {
-            unsigned __int64 const half_a=a>>1;
-            while(temp<half_a)
-            {
-                temp<<=1;
-                ++shift;
-            }
-        }
-        unsigned __int64 d=1I64<<shift;
-        if(a_large)
-        {
-            a-=temp;
-            res+=d;
-        }
-
-        while(a && temp && shift)
-        {
-            unsigned right_shift=0;
-            while(right_shift<shift && (temp>a))
-            {
-                temp>>=1;
-                ++right_shift;
-            }
-            d>>=right_shift;
-            shift-=right_shift;
-            a-=temp;
-            res+=d;
-        }
-        m_nVal=(negate?-(__int64)res:res);
-    }
-    
-    return *this;
-}
-
-
-fixed fixed::sqrt() const
-{
-    unsigned const max_shift=62;
-    unsigned __int64 a_squared=1I64<<max_shift;
-    unsigned b_shift=(max_shift+fixed_resolution_shift)/2;
-    unsigned __int64 a=1I64<<b_shift;
-    
-    unsigned __int64 x=m_nVal;
-    
-    while(b_shift && a_squared>x)
-    {
-        a>>=1;
-        a_squared>>=2;
-        --b_shift;
-    }
-
-    unsigned __int64 remainder=x-a_squared;
-    --b_shift;
-    
-    while(remainder && b_shift)
-    {
-        unsigned __int64 b_squared=1I64<<(2*b_shift-fixed_resolution_shift);
-        int const two_a_b_shift=b_shift+1-fixed_resolution_shift;
-        unsigned __int64 two_a_b=(two_a_b_shift>0)?(a<<two_a_b_shift):(a>>-two_a_b_shift);
-        
-        while(b_shift && remainder<(b_squared+two_a_b))
-        {
-            b_squared>>=2;
-            two_a_b>>=1;
-            --b_shift;
-        }
-        unsigned __int64 const delta=b_squared+two_a_b;
-        if((2*remainder)>delta)
-        {
-            a+=(1I64<<b_shift);
-            remainder-=delta;
-            if(b_shift)
-            {
-                --b_shift;
-            }
-        }
-    }
-    return fixed(internal(),a);
-}
-
-namespace
-{
-    int const max_power=63-fixed_resolution_shift;
-    __int64 const log_two_power_n_reversed[]={
-        0x18429946EI64,0x1791272EFI64,0x16DFB516FI64,0x162E42FF0I64,0x157CD0E70I64,0x14CB5ECF1I64,0x1419ECB71I64,0x13687A9F2I64,
-        0x12B708872I64,0x1205966F3I64,0x115424573I64,0x10A2B23F4I64,0xFF140274I64,0xF3FCE0F5I64,0xE8E5BF75I64,0xDDCE9DF6I64,
-        0xD2B77C76I64,0xC7A05AF7I64,0xBC893977I64,0xB17217F8I64,0xA65AF679I64,0x9B43D4F9I64,0x902CB379I64,0x851591FaI64,
-        0x79FE707bI64,0x6EE74EFbI64,0x63D02D7BI64,0x58B90BFcI64,0x4DA1EA7CI64,0x428AC8FdI64,0x3773A77DI64,0x2C5C85FeI64,
-        0x2145647EI64,0x162E42FfI64,0xB17217FI64
-    };
-    
-    __int64 const log_one_plus_two_power_minus_n[]={
-        0x67CC8FBI64,0x391FEF9I64,0x1E27077I64,0xF85186I64,
-        0x7E0A6CI64,0x3F8151I64,0x1FE02AI64,0xFF805I64,0x7FE01I64,0x3FF80I64,0x1FFE0I64,0xFFF8I64,
-        0x7FFEI64,0x4000I64,0x2000I64,0x1000I64,0x800I64,0x400I64,0x200I64,0x100I64,
-        0x80I64,0x40I64,0x20I64,0x10I64,0x8I64,0x4I64,0x2I64,0x1I64
-    };
-
-    __int64 const log_one_over_one_minus_two_power_minus_n[]={
-        0xB172180I64,0x49A5884I64,0x222F1D0I64,0x108598BI64,
-        0x820AECI64,0x408159I64,0x20202BI64,0x100805I64,0x80201I64,0x40080I64,0x20020I64,0x10008I64,
-        0x8002I64,0x4001I64,0x2000I64,0x1000I64,0x800I64,0x400I64,0x200I64,0x100I64,
-        0x80I64,0x40I64,0x20I64,0x10I64,0x8I64,0x4I64,0x2I64,0x1I64
-    };
-}
-
-
-fixed fixed::exp() const
-{
-    if(m_nVal>=log_two_power_n_reversed[0])
-    {
-        return fixed_max;
-    }
-    if(m_nVal<-log_two_power_n_reversed[63-2*fixed_resolution_shift])
-    {
-        return fixed(internal(),0);
-    }
-    if(!m_nVal)
-    {
-        return fixed(internal(),fixed_resolution);
-    }
-
-    __int64 res=fixed_resolution;
-
-    if(m_nVal>0)
-    {
-        int power=max_power;
-        __int64 const* log_entry=log_two_power_n_reversed;
-        __int64 temp=m_nVal;
-        while(temp && power>(-(int)fixed_resolution_shift))
-        {
-            while(!power || (temp<*log_entry))
-            {
-                if(!power)
-                {
-                    log_entry=log_one_plus_two_power_minus_n;
-                }
-                else
-                {
-                    ++log_entry;
-                }
-                --power;
-            }
-            temp-=*log_entry;
-            if(power<0)
-            {
-                res+=(res>>(-power));
-            }
-            else
-            {
-                res<<=power;
-            }
-        }
-    }
-    else
-    {
-        int power=fixed_resolution_shift;
-        __int64 const* log_entry=log_two_power_n_reversed+(max_power-power);
-        __int64 temp=m_nVal;
-
-        while(temp && power>(-(int)fixed_resolution_shift))
-        {
-            while(!power || (temp>(-*log_entry)))
-            {
-                if(!power)
-                {
-                    log_entry=log_one_over_one_minus_two_power_minus_n;
-                }
-                else
-                {
-                    ++log_entry;
-                }
-                --power;
-            }
-            temp+=*log_entry;
-            if(power<0)
-            {
-                res-=(res>>(-power));
-            }
-            else
-            {
-                res>>=power;
-            }
-        }
-    }
-    
-    return fixed(internal(),res);
-}
-
-fixed fixed::log() const
-{
-    if(m_nVal<=0)
-    {
-        return -fixed_max;
-    }
-    if(m_nVal==fixed_resolution)
-    {
-        return fixed_zero;
-    }
-    unsigned __int64 temp=m_nVal;
-    int left_shift=0;
-    unsigned __int64 const scale_position=0x8000000000000000;
-    while(temp<scale_position)
-    {
-        ++left_shift;
-        temp<<=1;
-    }
-    
-    __int64 res=(left_shift<max_power)?
-        log_two_power_n_reversed[left_shift]:
-        -log_two_power_n_reversed[2*max_power-left_shift];
-    unsigned right_shift=1;
-    unsigned __int64 shifted_temp=temp>>1;
-    while(temp && (right_shift<fixed_resolution_shift))
-    {
-        while((right_shift<fixed_resolution_shift) && (temp<(shifted_temp+scale_position)))
-        {
-            shifted_temp>>=1;
-            ++right_shift;
-        }
-        
-        temp-=shifted_temp;
-        shifted_temp=temp>>right_shift;
-        res+=log_one_over_one_minus_two_power_minus_n[right_shift-1];
-    }
-    return fixed(fixed::internal(),res);
-}
-
-
-namespace
-{
-    const long arctantab[32] = {
-        297197971, 210828714, 124459457, 65760959, 33381290, 16755422, 8385879,
-        4193963, 2097109, 1048571, 524287, 262144, 131072, 65536, 32768, 16384,
-        8192, 4096, 2048, 1024, 512, 256, 128, 64, 32, 16, 8, 4, 2, 1, 0, 0,
-    };
-
-
-    long scale_cordic_result(long a)
-    {
-        long const cordic_scale_factor=0x22C2DD1C; /* 0.271572 * 2^31*/
-        return (long)((((__int64)a)*cordic_scale_factor)>>31);
-    }
-    
-    long right_shift(long val,int shift)
-    {
-        return (shift<0)?(val<<-shift):(val>>shift);
-    }
-    
-    void perform_cordic_rotation(long&px, long&py, long theta)
-    {
-        long x = px, y = py;
-        long const *arctanptr = arctantab;
-        for (int i = -1; i <= (int)fixed_resolution_shift; ++i)
-        {
-            long const yshift=right_shift(y,i);
-            long const xshift=right_shift(x,i);
-
-            if (theta < 0)
-            {
-                x += yshift;
-                y -= xshift;
-                theta += *arctanptr++;
-            }
-            else
-            {
-                x -= yshift;
-                y += xshift;
-                theta -= *arctanptr++;
-            }
-        }
-        px = scale_cordic_result(x);
-        py = scale_cordic_result(y);
-    }
-
-
-    void perform_cordic_polarization(long& argx, long&argy)
-    {
-        long theta=0;
-        long x = argx, y = argy;
-        long const *arctanptr = arctantab;
-        for(int i = -1; i <= (int)fixed_resolution_shift; ++i)
-        {
-            long const yshift=right_shift(y,i);
-            long const xshift=right_shift(x,i);
-            if(y < 0)
-            {
-                y += xshift;
-                x -= yshift;
-                theta -= *arctanptr++;
-            }
-            else
-            {
-                y -= xshift;
-                x += yshift;
-                theta += *arctanptr++;
-            }
-        }
-        argx = scale_cordic_result(x);
-        argy = theta;
-    }
-}
-
-void fixed::sin_cos(fixed const& theta,fixed* s,fixed*c)
-{
-    __int64 x=theta.m_nVal%internal_two_pi;
-    if( x < 0 )
-        x += internal_two_pi;
-
-    bool negate_cos=false;
-    bool negate_sin=false;
-
-    if( x > internal_pi )
-    {
-        x =internal_two_pi-x;
-        negate_sin=true;
-    }
-    if(x>internal_half_pi)
-    {
-        x=internal_pi-x;
-        negate_cos=true;
-    }
-    long x_cos=1<<28,x_sin=0;
-
-    perform_cordic_rotation(x_cos,x_sin,(long)x);
-
-    if(s)
-    {
-        s->m_nVal=negate_sin?-x_sin:x_sin;
-    }
-    if(c)
-    {
-        c->m_nVal=negate_cos?-x_cos:x_cos;
-    }
-}
-
-fixed fixed::atan() const
-{
-    fixed r,theta;
-    to_polar(1,*this,&r,&theta);
-    return theta;
-}
-
-void fixed::to_polar(fixed const& x,fixed const& y,fixed* r,fixed*theta)
-{
-    bool const negative_x=x.m_nVal<0;
-    bool const negative_y=y.m_nVal<0;
-    
-    unsigned __int64 a=negative_x?-x.m_nVal:x.m_nVal;
-    unsigned __int64 b=negative_y?-y.m_nVal:y.m_nVal;
-
-    unsigned right_shift=0;
-    unsigned const max_value=1U<<fixed_resolution_shift;
-
-    while((a>=max_value) || (b>=max_value))
-    {
-        ++right_shift;
-        a>>=1;
-        b>>=1;
-    }
-    long xtemp=(long)a;
-    long ytemp=(long)b;
-    perform_cordic_polarization(xtemp,ytemp);
-    r->m_nVal=__int64(xtemp)<<right_shift;
-    theta->m_nVal=ytemp;
-
-    if(negative_x && negative_y)
-    {
-        theta->m_nVal-=internal_pi;
-    }
-    else if(negative_x)
-    {
-        theta->m_nVal=internal_pi-theta->m_nVal;
-    }
-    else if(negative_y)
-    {
-        theta->m_nVal=-theta->m_nVal;
-    }
-}
-
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// (C) Copyright 2007 Anthony Williams
+#ifndef FIXED_CPP
+#define FIXED_CPP
+#include "fixed.hpp"
+#include <string>
+#if !defined(FIXED_NO_FLOATING_POINT)
+#include <cmath>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if !defined(FIXED_PORTABLE_MULTIPLY)
+#if defined(__SIZEOF_INT128__)
+#define FIXED_INT128_MULTIPLY
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+#define FIXED_UMULH_MULTIPLY
+#endif
+#endif
+
+#if !defined(FIXED_PORTABLE_DIVIDE)
+#if defined(__GNUC__) && defined(__x86_64__)
+#define FIXED_ASM_DIVIDE
+#elif defined(_MSC_VER) && (_MSC_VER>=1920) && defined(_M_X64)
+#define FIXED_UDIV128_DIVIDE
+#endif
+#endif
+
+// SIMD kernels for the batch functions. Every level is compiled, with
+// FIXED_TARGET letting gcc and clang emit instructions beyond the ones the
+// whole file targets, and the one to use is picked at run time.
+#if !defined(FIXED_PORTABLE_BATCH) && (defined(__x86_64__) || defined(_M_X64))
+#if defined(__clang__) || (defined(__GNUC__) && (__GNUC__>=5)) || (defined(_MSC_VER) && (_MSC_VER>=1911))
+#define FIXED_DISPATCH_BATCH
+#endif
+#endif
+
+#if defined(FIXED_DISPATCH_BATCH)
+// gcc 12 before 12.3 warns of uninitialized values inside its own AVX-512
+// intrinsics wherever they are used
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#include <immintrin.h>
+#pragma GCC diagnostic pop
+#else
+#include <immintrin.h>
+#endif
+#include <cstdlib>
+#include <cstring>
+#if defined(__GNUC__)
+#include <cpuid.h>
+#define FIXED_TARGET(isa) __attribute__((target(isa)))
+#else
+#define FIXED_TARGET(isa)
+#endif
+#endif
+
+namespace
+{
+    // Multiplies two magnitudes and drops FracBits from the product, as
+    // fixed_portable_arithmetic does unless a faster way is available
+    template<typename StorageInt,unsigned FracBits>
+    struct fixed_multiplier:
+        fixed_portable_arithmetic<StorageInt,FracBits>
+    {};
+
+#if defined(FIXED_INT128_MULTIPLY)
+    // 64-bit formats use the compiler's 128-bit product where it has one
+    template<unsigned FracBits>
+    struct fixed_multiplier<__int64,FracBits>
+    {
+        static unsigned __int64 multiply(unsigned __int64 self,unsigned __int64 other)
+        {
+            unsigned __int128 const round_bias=fixed_round_multiply?(1I64<<(FracBits-1)):0;
+            return (unsigned __int64)(((unsigned __int128)self*other+round_bias)>>FracBits);
+        }
+    };
+#elif defined(FIXED_UMULH_MULTIPLY)
+    // or the upper half of the hardware product via __umulh on MSVC
+    template<unsigned FracBits>
+    struct fixed_multiplier<__int64,FracBits>
+    {
+        static unsigned __int64 multiply(unsigned __int64 self,unsigned __int64 other)
+        {
+            unsigned __int64 const round_bias=fixed_round_multiply?(1I64<<(FracBits-1)):0;
+            unsigned __int64 upper=__umulh(self,other);
+            unsigned __int64 lower=self*other;
+            lower+=round_bias;
+            upper+=(lower<round_bias);
+            return (upper<<(64-FracBits))|(lower>>FracBits);
+        }
+    };
+#endif
+}
+
+template<typename StorageInt,unsigned FracBits>
+basic_fixed<StorageInt,FracBits>& basic_fixed<StorageInt,FracBits>::multiply(basic_fixed const& val)
+{
+    bool const val_negative=val.m_nVal<0;
+    bool const this_negative=m_nVal<0;
+    bool const negate=val_negative ^ this_negative;
+    unsigned_storage_type const other=val_negative?0-unsigned_storage_type(val.m_nVal):val.m_nVal;
+    unsigned_storage_type const self=this_negative?0-unsigned_storage_type(m_nVal):m_nVal;
+    
+    unsigned_storage_type const res=fixed_multiplier<StorageInt,FracBits>::multiply(self,other);
+    m_nVal=StorageInt(negate?0-res:res);
+    return *this;
+}
+
+
+namespace
+{
+    // Number of leading zero bits in a non-zero value
+    FIXED_CONSTEXPR_ARITHMETIC inline unsigned count_leading_zeros(unsigned __int64 val)
+    {
+#if defined(__GNUC__)
+        return __builtin_clzll(val);
+#else
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+        if(!FIXED_IS_CONSTANT_EVALUATED())
+        {
+            unsigned long index=0;
+            _BitScanReverse64(&index,val);
+            return 63-index;
+        }
+#endif
+        unsigned count=0;
+        while(!(val&0x8000000000000000I64))
+        {
+            val<<=1;
+            ++count;
+        }
+        return count;
+#endif
+    }
+
+    // Divides two magnitudes with FracBits of extra precision, giving the
+    // truncated quotient, or max_value if that does not fit. The generic
+    // version is long division in chunks as wide as the divisor leaves
+    // free, one native divide per chunk.
+    template<typename StorageInt,unsigned FracBits>
+    struct fixed_divider
+    {
+        typedef typename fixed_storage_traits<StorageInt>::unsigned_type unsigned_type;
+
+        static unsigned_type divide(unsigned_type a,unsigned_type b)
+        {
+            unsigned_type const max_quotient=fixed_storage_traits<StorageInt>::max_value;
+            unsigned_type quotient=a/b;
+            if(quotient>(max_quotient>>FracBits))
+            {
+                return max_quotient;
+            }
+            unsigned const chunk=count_leading_zeros(b);
+            if(!chunk)
+            {
+                // b is 2^63, which leaves no room to shift the remainder
+                return a>>(fixed_storage_traits<StorageInt>::bits-1-FracBits);
+            }
+            unsigned_type remainder=a%b;
+            unsigned bits_left=FracBits;
+            while(bits_left)
+            {
+                unsigned const step=(chunk<bits_left)?chunk:bits_left;
+                remainder<<=step;
+                quotient=(quotient<<step)|(remainder/b);
+                remainder%=b;
+                bits_left-=step;
+            }
+            return quotient;
+        }
+    };
+
+    // 32-bit formats can divide the whole scaled dividend in 64 bits
+    template<unsigned FracBits>
+    struct fixed_divider<int,FracBits>:
+        fixed_portable_arithmetic<int,FracBits>
+    {};
+
+#if defined(FIXED_ASM_DIVIDE) || defined(FIXED_UDIV128_DIVIDE)
+    // 64-bit formats use the hardware 128/64 divide, which faults unless
+    // the quotient fits in 64 bits, so check that first
+    template<unsigned FracBits>
+    struct fixed_divider<__int64,FracBits>
+    {
+        static unsigned __int64 divide(unsigned __int64 a,unsigned __int64 b)
+        {
+            unsigned __int64 const max_quotient=0x7fffffffffffffffI64;
+            unsigned __int64 const upper=a>>(64-FracBits);
+            unsigned __int64 const lower=a<<FracBits;
+            if(upper>=b)
+            {
+                return max_quotient;
+            }
+            unsigned __int64 quotient,remainder;
+#if defined(FIXED_ASM_DIVIDE)
+            __asm__("divq %4" : "=a"(quotient),"=d"(remainder) : "a"(lower),"d"(upper),"rm"(b));
+#else
+            quotient=_udiv128(upper,lower,b,&remainder);
+#endif
+            return (quotient>max_quotient)?max_quotient:quotient;
+        }
+    };
+#endif
+}
+
+template<typename StorageInt,unsigned FracBits>
+basic_fixed<StorageInt,FracBits>& basic_fixed<StorageInt,FracBits>::divide(basic_fixed const& divisor)
+{
+    if( !divisor.m_nVal)
+    {
+        m_nVal=fixed_storage_traits<StorageInt>::max_value;
+    }
+    else
+    {
+        bool const negate_this=(m_nVal<0);
+        bool const negate_divisor=(divisor.m_nVal<0);
+        bool const negate=negate_this ^ negate_divisor;
+        unsigned_storage_type const a=negate_this?0-unsigned_storage_type(m_nVal):m_nVal;
+        unsigned_storage_type const b=negate_divisor?0-unsigned_storage_type(divisor.m_nVal):divisor.m_nVal;
+
+        unsigned_storage_type const res=fixed_divider<StorageInt,FracBits>::divide(a,b);
+        m_nVal=StorageInt(negate?0-res:res);
+    }
+    
+    return *this;
+}
+
+
+namespace
+{
+    // Upper half of the 128-bit product
+    FIXED_CONSTEXPR_ARITHMETIC inline unsigned __int64 multiply_high(unsigned __int64 lhs,unsigned __int64 rhs)
+    {
+#if defined(FIXED_INT128_MULTIPLY)
+        return (unsigned __int64)(((unsigned __int128)lhs*rhs)>>64);
+#else
+#if defined(FIXED_UMULH_MULTIPLY)
+        if(!FIXED_IS_CONSTANT_EVALUATED())
+        {
+            return __umulh(lhs,rhs);
+        }
+#endif
+        unsigned __int64 const lhs_upper=lhs>>32;
+        unsigned __int64 const lhs_lower=lhs&0xffffffff;
+        unsigned __int64 const rhs_upper=rhs>>32;
+        unsigned __int64 const rhs_lower=rhs&0xffffffff;
+        unsigned __int64 const lower_lower=lhs_lower*rhs_lower;
+        unsigned __int64 const upper_lower=lhs_upper*rhs_lower;
+        unsigned __int64 const lower_upper=lhs_lower*rhs_upper;
+        unsigned __int64 const middle=(lower_lower>>32)+(upper_lower&0xffffffff)+(lower_upper&0xffffffff);
+        return lhs_upper*rhs_upper+(upper_lower>>32)+(lower_upper>>32)+(middle>>32);
+#endif
+    }
+
+    // Shifts right with rounding by a count that may be negative or at
+    // least 64, saturating to limit if the result does not fit
+    FIXED_CONSTEXPR_ARITHMETIC inline unsigned __int64 round_shift_saturated(unsigned __int64 val,int shift,unsigned __int64 limit)
+    {
+        if(shift>64)
+        {
+            return 0;
+        }
+        if(shift<0)
+        {
+            if((shift<=-64) || (val>>(64+shift)))
+            {
+                return limit;
+            }
+            val<<=-shift;
+        }
+        else if(shift>0)
+        {
+            val=((val>>(shift-1))+1)>>1;
+        }
+        return (val>limit)?limit:val;
+    }
+
+    // 1/m in Q15 at the middle of each 1/512 step of m in [0.5,1)
+    unsigned short const reciprocal_seed[256]={
+        65408,65154,64902,64652,64404,64158,63913,63671,63430,63191,62954,62719,
+        62485,62253,62023,61795,61568,61343,61119,60897,60677,60458,60241,60026,
+        59812,59599,59388,59179,58971,58764,58559,58356,58153,57952,57753,57555,
+        57358,57163,56968,56776,56584,56394,56205,56017,55831,55646,55462,55279,
+        55098,54917,54738,54560,54383,54207,54033,53859,53687,53516,53346,53177,
+        53009,52842,52676,52511,52347,52184,52022,51862,51702,51543,51385,51228,
+        51072,50917,50763,50610,50458,50306,50156,50007,49858,49710,49563,49417,
+        49272,49128,48985,48842,48700,48559,48419,48280,48141,48003,47867,47730,
+        47595,47460,47326,47193,47061,46929,46798,46668,46539,46410,46282,46155,
+        46028,45902,45777,45652,45528,45405,45283,45161,45040,44919,44799,44680,
+        44561,44443,44326,44209,44093,43977,43862,43748,43634,43521,43408,43296,
+        43185,43074,42963,42854,42744,42636,42528,42420,42313,42207,42101,41996,
+        41891,41786,41683,41579,41476,41374,41272,41171,41070,40970,40870,40771,
+        40672,40574,40476,40378,40281,40185,40089,39993,39898,39804,39709,39616,
+        39522,39429,39337,39245,39153,39062,38971,38881,38791,38702,38613,38524,
+        38436,38348,38260,38173,38087,38000,37915,37829,37744,37659,37575,37491,
+        37407,37324,37241,37159,37077,36995,36914,36833,36752,36672,36592,36512,
+        36433,36354,36275,36197,36119,36041,35964,35887,35810,35734,35658,35583,
+        35507,35432,35358,35283,35209,35136,35062,34989,34916,34844,34771,34700,
+        34628,34557,34486,34415,34344,34274,34204,34135,34065,33996,33928,33859,
+        33791,33723,33655,33588,33521,33454,33387,33321,33255,33189,33124,33059,
+        32994,32929,32864,32800
+    };
+
+    // 1/sqrt(m) in Q15 at the middle of each 1/256 step of m in [0.25,1)
+    FIXED_CONSTEXPR unsigned short const rsqrt_seed[192]={
+        65281,64781,64292,63814,63347,62889,62442,62004,61575,61154,60742,60339,
+        59943,59555,59175,58801,58435,58075,57722,57376,57035,56700,56372,56049,
+        55731,55419,55112,54810,54513,54221,53933,53650,53371,53097,52826,52560,
+        52298,52040,51785,51535,51288,51044,50804,50567,50333,50103,49876,49652,
+        49430,49212,48997,48784,48574,48367,48163,47961,47761,47564,47370,47178,
+        46988,46800,46615,46432,46251,46072,45895,45720,45547,45376,45207,45040,
+        44875,44711,44550,44390,44232,44075,43920,43767,43615,43465,43316,43169,
+        43024,42879,42737,42595,42456,42317,42180,42044,41910,41776,41644,41514,
+        41384,41256,41129,41003,40878,40754,40631,40510,40390,40270,40152,40035,
+        39919,39803,39689,39576,39464,39352,39242,39133,39024,38916,38810,38704,
+        38599,38494,38391,38289,38187,38086,37986,37887,37788,37690,37593,37497,
+        37401,37307,37213,37119,37027,36935,36843,36753,36663,36573,36485,36397,
+        36309,36222,36136,36051,35966,35882,35798,35715,35632,35550,35469,35388,
+        35307,35228,35148,35070,34991,34914,34837,34760,34684,34608,34533,34458,
+        34384,34310,34237,34164,34092,34020,33949,33878,33807,33737,33668,33599,
+        33530,33461,33393,33326,33259,33192,33126,33060,32994,32929,32864,32800
+    };
+
+    // The seeds are good to about 8 bits, so two Newton steps are enough
+    // for 32-bit formats and three reach the 62 bits of the working format.
+    template<typename StorageInt>
+    struct newton_steps
+    {
+        static unsigned const count=(fixed_storage_traits<StorageInt>::bits>32)?3:2;
+    };
+
+    // Splits a non-zero a with frac_bits fractional bits into m*2^exponent
+    // with m in [0.25,1) held as Q0.64 and the exponent even, so that
+    // sqrt(a)=sqrt(m)*2^(exponent/2)
+    FIXED_CONSTEXPR_ARITHMETIC inline unsigned __int64 normalize_for_root(unsigned __int64 a,unsigned frac_bits,int& exponent)
+    {
+        unsigned const shift=count_leading_zeros(a);
+        unsigned __int64 m=a<<shift;
+        exponent=64-int(shift)-int(frac_bits);
+        if(exponent&1)
+        {
+            m>>=1;
+            ++exponent;
+        }
+        return m;
+    }
+
+    // 1/sqrt(m) in Q2.62 for m from normalize_for_root(); each step is
+    // y=y*(3-m*y*y)/2
+    template<typename StorageInt>
+    FIXED_CONSTEXPR_ARITHMETIC unsigned __int64 inverse_root(unsigned __int64 m)
+    {
+        unsigned __int64 y=(unsigned __int64)rsqrt_seed[(m>>56)-64]<<47;
+        for(unsigned i=0;i<newton_steps<StorageInt>::count;++i)
+        {
+            unsigned __int64 const y_squared=multiply_high(y,y)<<2;
+            unsigned __int64 const error=0xC000000000000000I64-multiply_high(m,y_squared);
+            y=multiply_high(y,error)<<1;
+        }
+        return y;
+    }
+
+    // Moves an estimate of round(sqrt(n)) that is off by at most one onto
+    // the right value; n is upper:lower and r is right when r*r-r<n<=r*r+r
+    FIXED_CONSTEXPR_ARITHMETIC inline unsigned __int64 correct_rounded_root(unsigned __int64 r,unsigned __int64 upper,unsigned __int64 lower)
+    {
+        unsigned __int64 const square_upper=multiply_high(r,r);
+        unsigned __int64 const square_lower=r*r;
+
+        unsigned __int64 const above_lower=square_lower+r;
+        unsigned __int64 const above_upper=square_upper+(above_lower<r);
+        if((above_upper<upper) || ((above_upper==upper) && (above_lower<lower)))
+        {
+            return r+1;
+        }
+        unsigned __int64 const below_lower=square_lower-r;
+        unsigned __int64 const below_upper=square_upper-(square_lower<r);
+        if((below_upper>upper) || ((below_upper==upper) && (below_lower>=lower)))
+        {
+            return r-1;
+        }
+        return r;
+    }
+
+    // Correctly rounded sqrt of a with frac_bits fractional bits, in the
+    // same format. sqrt(m)=m/sqrt(m) in Q62 gives an estimate within one
+    // of the rounded root of a*2^frac_bits, which is then corrected exactly.
+    template<typename StorageInt>
+    FIXED_CONSTEXPR_ARITHMETIC unsigned __int64 square_root(unsigned __int64 a,unsigned frac_bits)
+    {
+        int exponent=0;
+        unsigned __int64 const m=normalize_for_root(a,frac_bits,exponent);
+        unsigned __int64 const root_m=multiply_high(m,inverse_root<StorageInt>(m));
+        unsigned __int64 const estimate=round_shift_saturated(root_m,62-int(frac_bits)-exponent/2,~(unsigned __int64)0);
+
+        return correct_rounded_root(estimate,a>>(64-frac_bits),a<<frac_bits);
+    }
+}
+
+template<typename StorageInt,unsigned FracBits>
+basic_fixed<StorageInt,FracBits> basic_fixed<StorageInt,FracBits>::reciprocal() const
+{
+    unsigned __int64 const max_value=fixed_storage_traits<StorageInt>::max_value;
+    if(!m_nVal)
+    {
+        return basic_fixed(internal(),StorageInt(max_value));
+    }
+    bool const negate=m_nVal<0;
+    unsigned __int64 const a=negate?0-unsigned_storage_type(m_nVal):unsigned_storage_type(m_nVal);
+
+    // a=m*2^(64-shift) with m in [0.5,1) held as Q0.64, so 1/m is in (1,2]
+    unsigned const shift=count_leading_zeros(a);
+    unsigned __int64 const m=a<<shift;
+
+    // y~1/m in Q2.62; each step is y=y*(2-m*y)
+    unsigned __int64 y=(unsigned __int64)reciprocal_seed[(m>>55)&0xff]<<47;
+    for(unsigned i=0;i<newton_steps<StorageInt>::count;++i)
+    {
+        unsigned __int64 const error=0x8000000000000000I64-multiply_high(m,y);
+        y=multiply_high(y,error)<<2;
+    }
+
+    unsigned_storage_type const res=unsigned_storage_type(round_shift_saturated(y,126-int(shift)-2*int(FracBits),max_value));
+    return basic_fixed(internal(),StorageInt(negate?0-res:res));
+}
+
+template<typename StorageInt,unsigned FracBits>
+basic_fixed<StorageInt,FracBits> basic_fixed<StorageInt,FracBits>::rsqrt() const
+{
+    unsigned __int64 const max_value=fixed_storage_traits<StorageInt>::max_value;
+    if(m_nVal<=0)
+    {
+        return basic_fixed(internal(),StorageInt(max_value));
+    }
+    int exponent;
+    unsigned __int64 const m=normalize_for_root((unsigned_storage_type)m_nVal,FracBits,exponent);
+    unsigned __int64 const y=inverse_root<StorageInt>(m);
+
+    return basic_fixed(internal(),StorageInt(round_shift_saturated(y,62-int(FracBits)+exponent/2,max_value)));
+}
+
+template<typename StorageInt,unsigned FracBits>
+FIXED_CONSTEXPR_MATH basic_fixed<StorageInt,FracBits> basic_fixed<StorageInt,FracBits>::sqrt() const
+{
+    if(m_nVal<=0)
+    {
+        return basic_fixed();
+    }
+    unsigned __int64 const res=square_root<StorageInt>((unsigned_storage_type)m_nVal,FracBits);
+    return basic_fixed(internal(),StorageInt(res));
+}
+
+namespace
+{
+    // Adds a*a to the 128-bit value upper:lower
+    inline void add_square(unsigned __int64 a,unsigned __int64& upper,unsigned __int64& lower)
+    {
+        unsigned __int64 const square_lower=a*a;
+        lower+=square_lower;
+        upper+=multiply_high(a,a)+((lower<square_lower)?1:0);
+    }
+
+    // Correctly rounded sqrt of the 128-bit value upper:lower, saturated to
+    // limit. The top 64 bits after an even normalizing shift go through the
+    // same Newton kernel as sqrt().
+    inline unsigned __int64 root_of_wide(unsigned __int64 upper,unsigned __int64 lower,unsigned __int64 limit)
+    {
+        if(!upper && !lower)
+        {
+            return 0;
+        }
+        unsigned shift=upper?count_leading_zeros(upper):64+count_leading_zeros(lower);
+        shift&=~1u;
+        unsigned __int64 m;
+        if(shift>=64)
+        {
+            m=lower<<(shift-64);
+        }
+        else if(shift)
+        {
+            m=(upper<<shift)|(lower>>(64-shift));
+        }
+        else
+        {
+            m=upper;
+        }
+
+        // sqrt(m/2^64) in Q62, and sqrt(upper:lower)=that*2^(2-shift/2)
+        unsigned __int64 const root_m=multiply_high(m,inverse_root<__int64>(m));
+        unsigned __int64 res=round_shift_saturated(root_m,int(shift/2)-2,~(unsigned __int64)0);
+        if(res>limit)
+        {
+            return limit;
+        }
+        // the estimate is within one except for sums above 2^124, where
+        // the left shift above leaves it up to six away
+        for(int i=0;i<8;++i)
+        {
+            unsigned __int64 const corrected=correct_rounded_root(res,upper,lower);
+            if(corrected==res)
+            {
+                break;
+            }
+            res=corrected;
+        }
+        return (res>limit)?limit:res;
+    }
+}
+
+template<typename StorageInt,unsigned FracBits>
+basic_fixed<StorageInt,FracBits> basic_fixed<StorageInt,FracBits>::hypot(basic_fixed const& x,basic_fixed const& y)
+{
+    unsigned __int64 upper=0,lower=0;
+    add_square((x.m_nVal<0)?0-unsigned_storage_type(x.m_nVal):unsigned_storage_type(x.m_nVal),upper,lower);
+    add_square((y.m_nVal<0)?0-unsigned_storage_type(y.m_nVal):unsigned_storage_type(y.m_nVal),upper,lower);
+    return basic_fixed(internal(),StorageInt(root_of_wide(upper,lower,fixed_storage_traits<StorageInt>::max_value)));
+}
+
+template<typename StorageInt,unsigned FracBits>
+basic_fixed<StorageInt,FracBits> basic_fixed<StorageInt,FracBits>::hypot(basic_fixed const& x,basic_fixed const& y,basic_fixed const& z)
+{
+    unsigned __int64 upper=0,lower=0;
+    add_square((x.m_nVal<0)?0-unsigned_storage_type(x.m_nVal):unsigned_storage_type(x.m_nVal),upper,lower);
+    add_square((y.m_nVal<0)?0-unsigned_storage_type(y.m_nVal):unsigned_storage_type(y.m_nVal),upper,lower);
+    add_square((z.m_nVal<0)?0-unsigned_storage_type(z.m_nVal):unsigned_storage_type(z.m_nVal),upper,lower);
+    return basic_fixed(internal(),StorageInt(root_of_wide(upper,lower,fixed_storage_traits<StorageInt>::max_value)));
+}
+
+namespace
+{
+    // n*ln(2) in Q56
+    FIXED_CONSTEXPR __int64 const log_two_power_n[]={
+        0x0I64,0xB17217F7D1CF7AI64,0x162E42FEFA39EF3I64,0x2145647E7756E6DI64,
+        0x2C5C85FDF473DE7I64,0x3773A77D7190D60I64,0x428AC8FCEEADCDAI64,0x4DA1EA7C6BCAC54I64,
+        0x58B90BFBE8E7BCDI64,0x63D02D7B6604B47I64,0x6EE74EFAE321AC1I64,0x79FE707A603EA3AI64,
+        0x851591F9DD5B9B4I64,0x902CB3795A7892EI64,0x9B43D4F8D7958A7I64,0xA65AF67854B2821I64,
+        0xB17217F7D1CF79BI64,0xBC8939774EEC714I64,0xC7A05AF6CC0968EI64,0xD2B77C764926608I64,
+        0xDDCE9DF5C643581I64,0xE8E5BF7543604FBI64,0xF3FCE0F4C07D475I64,0xFF1402743D9A3EEI64,
+        0x10A2B23F3BAB7368I64,0x11542457337D42E2I64,0x1205966F2B4F125BI64,0x12B708872320E1D5I64,
+        0x13687A9F1AF2B14FI64,0x1419ECB712C480C8I64,0x14CB5ECF0A965042I64,0x157CD0E702681FBCI64,
+        0x162E42FEFA39EF35I64,0x16DFB516F20BBEAFI64,0x1791272EE9DD8E29I64,0x18429946E1AF5DA2I64,
+        0x18F40B5ED9812D1CI64,0x19A57D76D152FC96I64,0x1A56EF8EC924CC0FI64,0x1B0861A6C0F69B89I64,
+        0x1BB9D3BEB8C86B03I64,0x1C6B45D6B09A3A7DI64,0x1D1CB7EEA86C09F6I64,0x1DCE2A06A03DD970I64,
+        0x1E7F9C1E980FA8EAI64,0x1F310E368FE17863I64,0x1FE2804E87B347DDI64,0x2093F2667F851757I64,
+        0x2145647E7756E6D0I64,0x21F6D6966F28B64AI64,0x22A848AE66FA85C4I64,0x2359BAC65ECC553DI64,
+        0x240B2CDE569E24B7I64,0x24BC9EF64E6FF431I64,0x256E110E4641C3AAI64,0x261F83263E139324I64,
+        0x26D0F53E35E5629EI64,0x278267562DB73217I64,0x2833D96E25890191I64,0x28E54B861D5AD10BI64,
+        0x2996BD9E152CA084I64,0x2A482FB60CFE6FFEI64,0x2AF9A1CE04D03F78I64,0x2BAB13E5FCA20EF1I64
+    };
+    
+    // ln(1+2^-n) in Q62, starting at n=1
+    FIXED_CONSTEXPR __int64 const log_one_plus_two_power_minus_n[]={
+        0x19F323ECBF984BF3I64,0xE47FBE3CD4D10D6I64,0x789C1DB8ABCB97AI64,0x3E14618022C54CCI64,
+        0x1F829B0E7833005I64,0xFE054587E01F1EI64,0x7F80A9AC419E24I64,0x3FE01545621781I64,
+        0x1FF802A9AB10E6I64,0xFFE0055455888I64,0x7FF800AA9AAC4I64,0x3FFE001554556I64,
+        0x1FFF8002AA9ABI64,0xFFFE00055545I64,0x7FFF8000AAAAI64,0x3FFFE0001555I64,
+        0x1FFFF80002ABI64,0xFFFFE000055I64,0x7FFFF80000BI64,0x3FFFFE00001I64,
+        0x1FFFFF80000I64,0xFFFFFE0000I64,0x7FFFFF8000I64,0x3FFFFFE000I64,
+        0x1FFFFFF800I64,0xFFFFFFE00I64,0x7FFFFFF80I64,0x3FFFFFFE0I64,
+        0x1FFFFFFF8I64,0xFFFFFFFEI64,0x80000000I64,0x40000000I64,
+        0x20000000I64,0x10000000I64,0x8000000I64,0x4000000I64,
+        0x2000000I64,0x1000000I64,0x800000I64,0x400000I64,
+        0x200000I64,0x100000I64,0x80000I64,0x40000I64,
+        0x20000I64,0x10000I64,0x8000I64,0x4000I64,
+        0x2000I64,0x1000I64,0x800I64,0x400I64,
+        0x200I64,0x100I64,0x80I64,0x40I64,
+        0x20I64,0x10I64,0x8I64,0x4I64,
+        0x2I64,0x1I64
+    };
+
+    // -ln(1-2^-n) in Q62, starting at n=1
+    FIXED_CONSTEXPR __int64 const log_one_over_one_minus_two_power_minus_n[]={
+        0x2C5C85FDF473DE6BI64,0x1269621134DB9278I64,0x88BC74113F23DEFI64,0x421662D678E81A2I64,
+        0x2082BB13CE8888EI64,0x102056589358475I64,0x8080ABAC46F389I64,0x40201565622CD6I64,
+        0x200802ABAB113CI64,0x10020055655889I64,0x800800AABAAC4I64,0x4002001556556I64,
+        0x20008002AABABI64,0x1000200055565I64,0x80008000AAACI64,0x400020001555I64,
+        0x2000080002ABI64,0x100002000055I64,0x8000080000BI64,0x40000200001I64,
+        0x20000080000I64,0x10000020000I64,0x8000008000I64,0x4000002000I64,
+        0x2000000800I64,0x1000000200I64,0x800000080I64,0x400000020I64,
+        0x200000008I64,0x100000002I64,0x80000001I64,0x40000000I64,
+        0x20000000I64,0x10000000I64,0x8000000I64,0x4000000I64,
+        0x2000000I64,0x1000000I64,0x800000I64,0x400000I64,
+        0x200000I64,0x100000I64,0x80000I64,0x40000I64,
+        0x20000I64,0x10000I64,0x8000I64,0x4000I64,
+        0x2000I64,0x1000I64,0x800I64,0x400I64,
+        0x200I64,0x100I64,0x80I64,0x40I64,
+        0x20I64,0x10I64,0x8I64,0x4I64,
+        0x2I64,0x1I64
+    };
+
+    // The tables above carry more fractional bits than any format uses;
+    // these round an entry to FracBits.
+    template<unsigned FracBits>
+    struct fixed_log_tables
+    {
+        static FIXED_CONSTEXPR_ARITHMETIC __int64 two_power(int n)
+        {
+            __int64 const entry=(log_two_power_n[n<0?-n:n]+(1I64<<(55-FracBits)))>>(56-FracBits);
+            return (n<0)?-entry:entry;
+        }
+
+        static FIXED_CONSTEXPR_ARITHMETIC __int64 one_plus_two_power_minus(int n)
+        {
+            return (log_one_plus_two_power_minus_n[n-1]+(1I64<<(61-FracBits)))>>(62-FracBits);
+        }
+
+        static FIXED_CONSTEXPR_ARITHMETIC __int64 one_over_one_minus_two_power_minus(int n)
+        {
+            return (log_one_over_one_minus_two_power_minus_n[n-1]+(1I64<<(61-FracBits)))>>(62-FracBits);
+        }
+    };
+}
+
+
+namespace
+{
+    // ln(2) and ln(2)/32 in Q62, and 1/ln(2) in Q62 which is also
+    // 32/ln(2) in Q57
+    __int64 const ln_two=0x2C5C85FDF473DE6BI64;
+    unsigned __int64 const ln_two_over_32=0x162E42FEFA39EF3I64;
+    unsigned __int64 const one_over_ln_two=0x5C551D94AE0BF85EI64;
+
+    // 2^(j/32) in Q62
+    FIXED_CONSTEXPR __int64 const two_power_j_over_32[32]={
+        0x4000000000000000I64,0x4166C34C5615D0ECI64,0x42D561B3E6243D8AI64,0x444C0740496D4294I64,
+        0x45CAE0F1F545EB73I64,0x47521CC5A2E6A9E0I64,0x48E1E9B9D588E19BI64,0x4A7A77D47F7B84B1I64,
+        0x4C1BF828C6DC54B8I64,0x4DC69CDCEAA72A9CI64,0x4F7A993048D088D7I64,0x513821818624B40CI64,
+        0x52FF6B54D8A89C75I64,0x54D0AD5A753E077CI64,0x56AC1F752150A563I64,0x5891FAC0E95612C8I64,
+        0x5A827999FCEF3242I64,0x5C7DD7A3B17DCF75I64,0x5E8451CFAC061B5FI64,0x6096266533384A2BI64,
+        0x62B39508AA836D6FI64,0x64DCDEC3371793D1I64,0x6712460A8FC24072I64,0x69540EC8F895722DI64,
+        0x6BA27E656B4EB57AI64,0x6DFDDBCBED791BABI64,0x70666F76154A7089I64,0x72DC8373BE41A454I64,
+        0x75606373EE921C97I64,0x77F25CCDEE6D7AE6I64,0x7A92BE8A92436616I64,0x7D41D96DB915019DI64
+    };
+
+    // 1/c in Q62 for c=1+(j+0.5)/64, and -ln of each stored value in Q62
+    FIXED_CONSTEXPR unsigned __int64 const log_reciprocal[64]={
+        0x3F80FE03F80FE040I64,0x3E88CB3C9484E2B0I64,0x3D980F6603D980F6I64,0x3CAE759203CAE759I64,
+        0x3BCBADC7F10D148EI64,0x3AEF6CA970586723I64,0x3A196B1EDD80E866I64,0x3949660ABDC32204I64,
+        0x387F1E0387F1E038I64,0x37BA5713280DEE96I64,0x36FAD87BB4671656I64,0x36406C80D901B203I64,
+        0x358AE0358AE0358BI64,0x34DA034DA034DA03I64,0x342DA7F2F4960343I64,0x3385A29DC9420338I64,
+        0x32E1C9F01970E4F8I64,0x3241F693A1C451ABI64,0x31A6031A6031A603I64,0x310DCBE157609329I64,
+        0x30792EF5657DBA52I64,0x2FE80BFA02FE80C0I64,0x2F5A4411C1D986A9I64,0x2ECFB9C869536203I64,
+        0x2E4850FE8DBD780CI64,0x2DC3EED6866F8D96I64,0x2D4279A2A6E52088I64,0x2CC3D8D4A245F203I64,
+        0x2C47F4EE02C47F4FI64,0x2BCEB771A02BCEB7I64,0x2B580AD602B580ADI64,0x2AE3DA78A0D67344I64,
+        0x2A721291E81FD58EI64,0x2A02A02A02A02A03I64,0x2995710E4B5EDCEAI64,0x292A73C765A0CDD4I64,
+        0x28C1978FEB9F3438I64,0x285ACC4BAA3F0DDFI64,0x27F6027F6027F602I64,0x27932B48F757CE88I64,
+        0x2732385830FEC66EI64,0x26D31BE7BC0E8F2AI64,0x2675C8B6AF7963C2I64,0x261A320261A32026I64,
+        0x25C04B8097012E02I64,0x2568095A02568096I64,0x2511602511602511I64,0x24BC44E10125E227I64,
+        0x2468ACF13579BE02I64,0x24168E18CF81B10FI64,0x23C5DE767F70E886I64,0x237694808DDA5202I64,
+        0x2328A70119453809I64,0x22DC0D1284E6F1D7I64,0x2290BE1C159A76D2I64,0x2246B1CEBA6066D4I64,
+        0x21FDE021FDE021FEI64,0x21B641511E8D2B32I64,0x216FCDD84B3B8F27I64,0x212A7E720212A7E7I64,
+        0x20E64C148FEF8CDAI64,0x20A32FEFAE680829I64,0x2061236A3EBC349EI64,0x2020202020202020I64
+    };
+
+    FIXED_CONSTEXPR __int64 const log_of_log_reciprocal[64]={
+        0x7F80A9AC419E23I64,0x17B91B07D5B11AAI64,0x273D0F73FD7ABF6I64,0x3685BAE232E37D8I64,
+        0x4594DBBA8DEB83AI64,0x546C1CFC1860FDAI64,0x630D1758C66C83DI64,0x7179523D6F1D0C5I64,
+        0x7FB244C76FAAEABI64,0x8DB956A97B3D014I64,0x9B8FE100F47BA1EI64,0xA9372F1D0DA1BD2I64,
+        0xB6B07F38CE90E47I64,0xC3FD03290648848I64,0xD11DE0FF15AB18CI64,0xDE1433A16C66B15I64,
+        0xEAE10B5A7DDC8AEI64,0xF7856E5EE2C9B29I64,0x10402594B4D040DBI64,0x11058BF9AE4AD519I64,
+        0x11C898C16999FAFCI64,0x12895A13DE86A35EI64,0x1347DD9A987D54D6I64,0x1404308686A7E3BDI64,
+        0x14BE5F957778A0DBI64,0x15767717455A6C55I64,0x162C82F2B9C7952FI64,0x16E08EAA2BA1E38CI64,
+        0x1792A55FDD47A27CI64,0x1842D1DA1E8B174AI64,0x18F11E873662C77FI64,0x199D958117E08ACCI64,
+        0x1A484090E5BB0A2CI64,0x1AF1293247786B11I64,0x1B9858969310FB59I64,0x1C3DD7A7CDAD4D74I64,
+        0x1CE1AF0B85F3EB7CI64,0x1D83E7258A2F3E51I64,0x1E24881A7C6C261EI64,0x1EC399D2468CC017I64,
+        0x1F6123FA7028AC62I64,0x1FFD2E0857F49856I64,0x2097BF3B524DA4CBI64,0x2130DE9EAE6A4172I64,
+        0x21C8930BA39917EEI64,0x225EE32B27DF78A5I64,0x22F3D577B1334180I64,0x2387703EE2784979I64,
+        0x2419B9A32556DB27I64,0x24AAB79D31EF9677I64,0x253A6FFD85611591I64,0x25C8E86DC804D081I64,
+        0x26562672243AE264I64,0x26E22F6A8E8F6B8BI64,0x276D0893FFF8455EI64,0x27F6B709A2DE84B7I64,
+        0x287F3FC5F39CCEF5I64,0x2906A7A3D511BEE7I64,0x298CF35F99DC7362I64,0x2A12279802D0D698I64,
+        0x2A9648CF33292F52I64,0x2B195B6B9AF31261I64,0x2B9B63B8D82EC91AI64,0x2C1C65E88F11B195I64
+    };
+
+    // Taylor coefficients in Q62: 1/k! for exp(r), (-1)^k/(k+1) for ln(1+u)/u.
+    // Over the reduced ranges (|r|<=ln(2)/64, |u|<1/128) these are within a
+    // bit of the minimax coefficients, and the truncation error is below
+    // 2^-48 at the 64-bit degree and 2^-30 at the 32-bit one.
+    FIXED_CONSTEXPR __int64 const exp_series[6]={
+        0x4000000000000000I64,0x4000000000000000I64,0x2000000000000000I64,0xAAAAAAAAAAAAAABI64,
+        0x2AAAAAAAAAAAAABI64,0x88888888888889I64
+    };
+
+    FIXED_CONSTEXPR __int64 const log_series[6]={
+        0x4000000000000000I64,-0x2000000000000000I64,0x1555555555555555I64,
+        -0x1000000000000000I64,0xCCCCCCCCCCCCCCDI64,-0xAAAAAAAAAAAAAABI64
+    };
+
+    template<typename StorageInt>
+    struct series_degree
+    {
+        static unsigned const exp=(fixed_storage_traits<StorageInt>::bits>32)?5:3;
+        static unsigned const log=(fixed_storage_traits<StorageInt>::bits>32)?5:2;
+    };
+
+    // Product of two signed Q62 values
+    FIXED_CONSTEXPR_ARITHMETIC inline __int64 multiply_q62(__int64 lhs,__int64 rhs)
+    {
+        unsigned __int64 upper=multiply_high((unsigned __int64)lhs,(unsigned __int64)rhs);
+        if(lhs<0)
+        {
+            upper-=(unsigned __int64)rhs;
+        }
+        if(rhs<0)
+        {
+            upper-=(unsigned __int64)lhs;
+        }
+        unsigned __int64 const lower=(unsigned __int64)lhs*(unsigned __int64)rhs;
+        return (__int64)((upper<<2)|(lower>>62));
+    }
+
+    // Horner evaluation of a Q62 polynomial of the given degree
+    template<unsigned Degree>
+    FIXED_CONSTEXPR_ARITHMETIC __int64 evaluate_series(__int64 const* coefficients,__int64 x)
+    {
+        __int64 res=coefficients[Degree];
+        for(int i=int(Degree)-1;i>=0;--i)
+        {
+            res=coefficients[i]+multiply_q62(res,x);
+        }
+        return res;
+    }
+
+    // 2^(j/32)*exp(r) in Q62 for n=32*k+j and |r|<=ln(2)/64 in Q62; the
+    // caller applies 2^k
+    template<typename StorageInt>
+    FIXED_CONSTEXPR_ARITHMETIC __int64 exp_mantissa(__int64 n,__int64 r)
+    {
+        __int64 const exp_r=evaluate_series<series_degree<StorageInt>::exp>(exp_series,r);
+        return multiply_q62(exp_r,two_power_j_over_32[n&31]);
+    }
+
+    // ln(m) in Q62 for m in [1,2) held as Q1.63. m=c*(1+u) with c from the
+    // table picked by the top bits of m, so |u|<1/128.
+    template<typename StorageInt>
+    FIXED_CONSTEXPR_ARITHMETIC __int64 log_mantissa(unsigned __int64 m)
+    {
+        unsigned const j=unsigned(m>>57)&63;
+        unsigned __int64 const product_upper=multiply_high(m,log_reciprocal[j]);
+        unsigned __int64 const product_lower=m*log_reciprocal[j];
+        __int64 const u=(__int64)((product_upper<<1)|(product_lower>>63))-0x4000000000000000I64;
+
+        return log_of_log_reciprocal[j]
+            +multiply_q62(u,evaluate_series<series_degree<StorageInt>::log>(log_series,u));
+    }
+
+    // log2(a) in Q56 for a non-zero a with frac_bits fractional bits
+    template<typename StorageInt>
+    __int64 log2_q56(unsigned __int64 a,unsigned frac_bits)
+    {
+        unsigned const shift=count_leading_zeros(a);
+        int const exponent=63-int(shift)-int(frac_bits);
+        __int64 const log2_m=multiply_q62(log_mantissa<StorageInt>(a<<shift),(__int64)one_over_ln_two);
+        return (__int64)((unsigned __int64)(__int64)exponent<<56)+((log2_m+32)>>6);
+    }
+
+    // 2^t for t in Q56, rounded to frac_bits and saturated to limit
+    template<typename StorageInt>
+    unsigned __int64 exp2_q56(__int64 t,unsigned frac_bits,unsigned __int64 limit)
+    {
+        // t=n/32+f with |f|<=1/64, so 2^t=2^(n/32)*exp(f*ln(2))
+        __int64 const n=(t+(1I64<<50))>>51;
+        __int64 const f=(__int64)((unsigned __int64)t-((unsigned __int64)n<<51));
+        __int64 const res=exp_mantissa<StorageInt>(n,multiply_q62((__int64)((unsigned __int64)f<<6),ln_two));
+        return round_shift_saturated(res,62-int(frac_bits)-int(n>>5),limit);
+    }
+}
+
+#if defined(FIXED_FAST_EXP_LOG)
+
+template<typename StorageInt,unsigned FracBits>
+FIXED_CONSTEXPR_MATH basic_fixed<StorageInt,FracBits> basic_fixed<StorageInt,FracBits>::exp() const
+{
+    typedef fixed_log_tables<FracBits> tables;
+    int const max_power=fixed_storage_traits<StorageInt>::bits-1-FracBits;
+    unsigned __int64 const max_value=fixed_storage_traits<StorageInt>::max_value;
+
+    if(m_nVal>=tables::two_power(max_power))
+    {
+        return basic_fixed(internal(),StorageInt(max_value));
+    }
+    if(m_nVal<-tables::two_power(FracBits))
+    {
+        return basic_fixed(internal(),0);
+    }
+
+    // x=n*ln(2)/32+r with |r|<=ln(2)/64, and n=32*k+j so that
+    // exp(x)=2^k*2^(j/32)*exp(r). r is small enough that the subtraction
+    // can be done modulo 2^64 in Q62 without losing anything.
+    bool const negative=m_nVal<0;
+    unsigned __int64 const magnitude=(unsigned_storage_type)(negative?-m_nVal:m_nVal);
+    __int64 const n_magnitude=(__int64)round_shift_saturated(
+        multiply_high(magnitude,one_over_ln_two),int(FracBits)-7,~(unsigned __int64)0);
+    __int64 const n=negative?-n_magnitude:n_magnitude;
+    __int64 const r=(__int64)(((unsigned __int64)(__int64)m_nVal<<(62-FracBits))
+        -(unsigned __int64)n*ln_two_over_32);
+
+    __int64 const res=exp_mantissa<StorageInt>(n,r);
+    int const k=int(n>>5);
+
+    return basic_fixed(internal(),StorageInt(round_shift_saturated(res,62-int(FracBits)-k,max_value)));
+}
+
+template<typename StorageInt,unsigned FracBits>
+FIXED_CONSTEXPR_MATH basic_fixed<StorageInt,FracBits> basic_fixed<StorageInt,FracBits>::log() const
+{
+    if(m_nVal<=0)
+    {
+        return -basic_fixed(internal(),fixed_storage_traits<StorageInt>::max_value);
+    }
+    if(m_nVal==resolution)
+    {
+        return basic_fixed(internal(),0);
+    }
+
+    // x=m*2^exponent with m in [1,2) held as Q1.63
+    unsigned __int64 const a=(unsigned_storage_type)m_nVal;
+    unsigned const shift=count_leading_zeros(a);
+    int const exponent=63-int(shift)-int(FracBits);
+    __int64 const log_m=log_mantissa<StorageInt>(a<<shift);
+
+    // exponent*ln(2) needs the headroom of Q56
+    __int64 const log_two_power=(exponent<0)?
+        -log_two_power_n[-exponent]:
+        log_two_power_n[exponent];
+    __int64 const res=log_two_power+((log_m+32)>>6);
+    return basic_fixed(internal(),StorageInt((res+(1I64<<(55-FracBits)))>>(56-FracBits)));
+}
+
+#else
+
+template<typename StorageInt,unsigned FracBits>
+FIXED_CONSTEXPR_MATH basic_fixed<StorageInt,FracBits> basic_fixed<StorageInt,FracBits>::exp() const
+{
+    typedef fixed_log_tables<FracBits> tables;
+    int const max_power=fixed_storage_traits<StorageInt>::bits-1-FracBits;
+
+    if(m_nVal>=tables::two_power(max_power))
+    {
+        return basic_fixed(internal(),fixed_storage_traits<StorageInt>::max_value);
+    }
+    if(m_nVal<-tables::two_power(FracBits))
+    {
+        return basic_fixed(internal(),0);
+    }
+    if(!m_nVal)
+    {
+        return basic_fixed(internal(),resolution);
+    }
+
+    StorageInt res=resolution;
+
+    if(m_nVal>0)
+    {
+        int power=max_power;
+        StorageInt log_entry=StorageInt(tables::two_power(power));
+        StorageInt temp=m_nVal;
+        while(temp && power>(-(int)FracBits))
+        {
+            while(!power || (temp<log_entry))
+            {
+                --power;
+                log_entry=StorageInt((power<0)?
+                    tables::one_plus_two_power_minus(-power):
+                    tables::two_power(power));
+            }
+            temp-=log_entry;
+            if(power<0)
+            {
+                res+=(res>>(-power));
+            }
+            else
+            {
+                res<<=power;
+            }
+        }
+    }
+    else
+    {
+        int power=FracBits;
+        StorageInt log_entry=StorageInt(tables::two_power(power));
+        StorageInt temp=m_nVal;
+
+        while(temp && power>(-(int)FracBits))
+        {
+            while(!power || (temp>(-log_entry)))
+            {
+                --power;
+                log_entry=StorageInt((power<0)?
+                    tables::one_over_one_minus_two_power_minus(-power):
+                    tables::two_power(power));
+            }
+            temp+=log_entry;
+            if(power<0)
+            {
+                res-=(res>>(-power));
+            }
+            else
+            {
+                res>>=power;
+            }
+        }
+    }
+    
+    return basic_fixed(internal(),res);
+}
+
+template<typename StorageInt,unsigned FracBits>
+FIXED_CONSTEXPR_MATH basic_fixed<StorageInt,FracBits> basic_fixed<StorageInt,FracBits>::log() const
+{
+    typedef fixed_log_tables<FracBits> tables;
+    unsigned const bits=fixed_storage_traits<StorageInt>::bits;
+    int const max_power=bits-1-FracBits;
+
+    if(m_nVal<=0)
+    {
+        return -basic_fixed(internal(),fixed_storage_traits<StorageInt>::max_value);
+    }
+    if(m_nVal==resolution)
+    {
+        return basic_fixed(internal(),0);
+    }
+    unsigned_storage_type temp=m_nVal;
+    int left_shift=0;
+    unsigned_storage_type const scale_position=unsigned_storage_type(1)<<(bits-1);
+    while(temp<scale_position)
+    {
+        ++left_shift;
+        temp<<=1;
+    }
+    
+    StorageInt res=StorageInt(tables::two_power(max_power-left_shift));
+    unsigned right_shift=1;
+    unsigned_storage_type shifted_temp=temp>>1;
+    while(temp && (right_shift<FracBits))
+    {
+        while((right_shift<FracBits) && (temp<(shifted_temp+scale_position)))
+        {
+            shifted_temp>>=1;
+            ++right_shift;
+        }
+        
+        temp-=shifted_temp;
+        shifted_temp=temp>>right_shift;
+        res+=StorageInt(tables::one_over_one_minus_two_power_minus(right_shift));
+    }
+    return basic_fixed(internal(),res);
+}
+
+
+#endif
+
+template<typename StorageInt,unsigned FracBits>
+basic_fixed<StorageInt,FracBits> basic_fixed<StorageInt,FracBits>::exp2() const
+{
+    int const max_power=fixed_storage_traits<StorageInt>::bits-1-FracBits;
+    unsigned __int64 const max_value=fixed_storage_traits<StorageInt>::max_value;
+
+    if(m_nVal>=(StorageInt(max_power)<<FracBits))
+    {
+        return basic_fixed(internal(),StorageInt(max_value));
+    }
+    if(m_nVal<-(StorageInt(FracBits+1)<<FracBits))
+    {
+        return basic_fixed(internal(),0);
+    }
+    __int64 const t=(__int64)((unsigned __int64)(__int64)m_nVal<<(56-FracBits));
+    return basic_fixed(internal(),StorageInt(exp2_q56<StorageInt>(t,FracBits,max_value)));
+}
+
+template<typename StorageInt,unsigned FracBits>
+basic_fixed<StorageInt,FracBits> basic_fixed<StorageInt,FracBits>::log2() const
+{
+    if(m_nVal<=0)
+    {
+        return -basic_fixed(internal(),fixed_storage_traits<StorageInt>::max_value);
+    }
+    __int64 const res=log2_q56<StorageInt>((unsigned_storage_type)m_nVal,FracBits);
+    return basic_fixed(internal(),StorageInt((res+(1I64<<(55-FracBits)))>>(56-FracBits)));
+}
+
+template<typename StorageInt,unsigned FracBits>
+basic_fixed<StorageInt,FracBits> basic_fixed<StorageInt,FracBits>::pow(basic_fixed const& y) const
+{
+    int const max_power=fixed_storage_traits<StorageInt>::bits-1-FracBits;
+    unsigned __int64 const max_value=fixed_storage_traits<StorageInt>::max_value;
+
+    if(!y.m_nVal)
+    {
+        return basic_fixed(internal(),resolution);
+    }
+    if(!m_nVal)
+    {
+        return basic_fixed(internal(),(y.m_nVal>0)?0:StorageInt(max_value));
+    }
+    bool negate=false;
+    if(m_nVal<0)
+    {
+        // only integral powers of a negative base are real
+        if(y.m_nVal%resolution)
+        {
+            return basic_fixed(internal(),0);
+        }
+        negate=((y.m_nVal>>FracBits)&1)!=0;
+    }
+
+    // t=y*log2(|x|) in Q56, from the 128-bit product of the magnitudes
+    __int64 const log2_x=log2_q56<StorageInt>(m_nVal<0?0-unsigned_storage_type(m_nVal):unsigned_storage_type(m_nVal),FracBits);
+    bool const negative_t=(log2_x<0)!=(y.m_nVal<0);
+    unsigned __int64 const log2_magnitude=(unsigned __int64)(log2_x<0?-log2_x:log2_x);
+    unsigned __int64 const y_magnitude=y.m_nVal<0?0-unsigned_storage_type(y.m_nVal):unsigned_storage_type(y.m_nVal);
+    unsigned __int64 const upper=multiply_high(log2_magnitude,y_magnitude);
+    unsigned __int64 const lower=log2_magnitude*y_magnitude;
+
+    StorageInt res;
+    if((upper>>(FracBits-1)) || (((upper<<(64-FracBits))|(lower>>FracBits))>=((unsigned __int64)64<<56)))
+    {
+        // |t|>=64 is out of range for every format
+        res=negative_t?0:StorageInt(max_value);
+    }
+    else
+    {
+        __int64 const t_magnitude=(__int64)((upper<<(64-FracBits))|(lower>>FracBits));
+        __int64 const t=negative_t?-t_magnitude:t_magnitude;
+        if(t>=((__int64)max_power<<56))
+        {
+            res=StorageInt(max_value);
+        }
+        else if(t<-((__int64)(FracBits+1)<<56))
+        {
+            res=0;
+        }
+        else
+        {
+            res=StorageInt(exp2_q56<StorageInt>(t,FracBits,max_value));
+        }
+    }
+    return basic_fixed(internal(),negate?-res:res);
+}
+
+namespace
+{
+    // A non-zero magnitude upper:lower*2^exponent with upper:lower in
+    // [0.5,1) held as Q0.128
+    struct wide_magnitude
+    {
+        unsigned __int64 upper;
+        unsigned __int64 lower;
+        int exponent;
+    };
+
+    // Splits a non-zero a with frac_bits fractional bits into a
+    // wide_magnitude, or 1/a when invert is set. The reciprocal is long
+    // division of 2^191 by the normalized a, truncated to 128 bits.
+    inline wide_magnitude to_wide_magnitude(unsigned __int64 a,unsigned frac_bits,bool invert)
+    {
+        unsigned const shift=count_leading_zeros(a);
+        unsigned __int64 const m=a<<shift;
+        wide_magnitude res;
+        res.upper=m;
+        res.lower=0;
+        res.exponent=64-int(shift)-int(frac_bits);
+        if(invert)
+        {
+            // 1/(m*2^exponent) is 2^191/m as Q0.128 times 2^(1-exponent),
+            // except that a power of two has the exact reciprocal m*2^(2-exponent)
+            res.exponent=((m==0x8000000000000000I64)?2:1)-res.exponent;
+            if(m!=0x8000000000000000I64)
+            {
+                unsigned __int64 remainder=0x8000000000000000I64;
+                res.upper=0;
+                for(unsigned i=0;i<128;++i)
+                {
+                    unsigned __int64 const carry=remainder>>63;
+                    remainder<<=1;
+                    unsigned __int64 const bit=(carry || (remainder>=m))?1:0;
+                    remainder-=bit?m:0;
+                    res.upper=(res.upper<<1)|(res.lower>>63);
+                    res.lower=(res.lower<<1)|bit;
+                }
+            }
+        }
+        return res;
+    }
+
+    // a*b truncated to 128 bits of mantissa; the partial product of the
+    // lower halves is below the last bit kept, so it is left out
+    inline wide_magnitude multiply_wide(wide_magnitude const& a,wide_magnitude const& b)
+    {
+        unsigned __int64 const cross_upper=multiply_high(a.upper,b.lower);
+        unsigned __int64 const cross_lower=multiply_high(a.lower,b.upper);
+        wide_magnitude res;
+        res.upper=multiply_high(a.upper,b.upper);
+        res.lower=a.upper*b.upper+cross_upper;
+        res.upper+=(res.lower<cross_upper);
+        res.lower+=cross_lower;
+        res.upper+=(res.lower<cross_lower);
+        res.exponent=a.exponent+b.exponent;
+        if(!(res.upper>>63))
+        {
+            res.upper=(res.upper<<1)|(res.lower>>63);
+            res.lower<<=1;
+            --res.exponent;
+        }
+        return res;
+    }
+}
+
+template<typename StorageInt,unsigned FracBits>
+basic_fixed<StorageInt,FracBits> basic_fixed<StorageInt,FracBits>::pown(int n) const
+{
+    unsigned __int64 const max_value=fixed_storage_traits<StorageInt>::max_value;
+    // beyond 2^+-exponent_limit every format has saturated or reached zero
+    int const exponent_limit=128;
+
+    if(!n)
+    {
+        return basic_fixed(internal(),resolution);
+    }
+    if(!m_nVal)
+    {
+        return basic_fixed(internal(),(n>0)?0:StorageInt(max_value));
+    }
+    unsigned power=(n<0)?0u-unsigned(n):unsigned(n);
+    bool const negate=(m_nVal<0) && (power&1);
+    unsigned __int64 const a=m_nVal<0?0-unsigned_storage_type(m_nVal):unsigned_storage_type(m_nVal);
+
+    // (1/x)^|n| for a negative n, so small powers do not lose their bits
+    wide_magnitude square=to_wide_magnitude(a,FracBits,n<0);
+    wide_magnitude res={0x8000000000000000I64,0,1};
+    for(;;)
+    {
+        if(power&1)
+        {
+            res=multiply_wide(res,square);
+        }
+        power>>=1;
+        if(!power)
+        {
+            break;
+        }
+        if((square.exponent>exponent_limit) || (square.exponent<-exponent_limit))
+        {
+            // every power lies on the same side of one as square, so the
+            // remaining factors only take the result further out
+            res=square;
+            break;
+        }
+        square=multiply_wide(square,square);
+    }
+
+    StorageInt const val=StorageInt(round_shift_saturated(res.upper,64-int(FracBits)-res.exponent,max_value));
+    return basic_fixed(internal(),negate?-val:val);
+}
+
+namespace
+{
+    // The CORDIC kernels work on Q28 values in a long whatever the format
+    // of the caller; angles and results are rescaled on the way in and out.
+    unsigned const cordic_shift=28;
+
+    FIXED_CONSTEXPR long const arctantab[32] = {
+        297197971, 210828714, 124459457, 65760959, 33381290, 16755422, 8385879,
+        4193963, 2097109, 1048571, 524287, 262144, 131072, 65536, 32768, 16384,
+        8192, 4096, 2048, 1024, 512, 256, 128, 64, 32, 16, 8, 4, 2, 1, 0, 0,
+    };
+
+
+    // 1/gain in Q31 after each number of steps; 0.271572 once converged
+    FIXED_CONSTEXPR long const cordic_scale_factor[fixed_cordic_iterations]={
+        0x393E4B8B, 0x287A26C5, 0x243430A4, 0x231F770C, 0x22DA0825, 0x22C8A828,
+        0x22C44FE4, 0x22C339CE, 0x22C2F449, 0x22C2E2E7, 0x22C2DE8F, 0x22C2DD79,
+        0x22C2DD33, 0x22C2DD22, 0x22C2DD1D, 0x22C2DD1C, 0x22C2DD1C, 0x22C2DD1C,
+        0x22C2DD1C, 0x22C2DD1C, 0x22C2DD1C, 0x22C2DD1C, 0x22C2DD1C, 0x22C2DD1C,
+        0x22C2DD1C, 0x22C2DD1C, 0x22C2DD1C, 0x22C2DD1C, 0x22C2DD1C, 0x22C2DD1C,
+    };
+
+    FIXED_CONSTEXPR_ARITHMETIC int clamp_cordic_iterations(unsigned iterations)
+    {
+        if(!iterations)
+        {
+            return 1;
+        }
+        return int((iterations<fixed_cordic_iterations)?iterations:fixed_cordic_iterations);
+    }
+
+    FIXED_CONSTEXPR_ARITHMETIC long scale_cordic_result(long a,int iterations)
+    {
+        return (long)((((__int64)a)*cordic_scale_factor[iterations-1])>>31);
+    }
+    
+    template<typename T>
+    FIXED_CONSTEXPR_ARITHMETIC T right_shift(T val,int shift)
+    {
+        return (shift<0)?(val<<-shift):(val>>shift);
+    }
+
+    template<unsigned FracBits,typename T>
+    FIXED_CONSTEXPR_ARITHMETIC T to_cordic_scale(T val)
+    {
+        return right_shift(val,int(FracBits)-int(cordic_shift));
+    }
+
+    template<unsigned FracBits,typename T>
+    FIXED_CONSTEXPR_ARITHMETIC T from_cordic_scale(T val)
+    {
+        return right_shift(val,int(cordic_shift)-int(FracBits));
+    }
+    
+    FIXED_CONSTEXPR_ARITHMETIC inline void perform_cordic_rotation(long&px, long&py, long theta,int iterations)
+    {
+        long x = px, y = py;
+        long const *arctanptr = arctantab;
+        for (int i = -1; i < iterations-1; ++i)
+        {
+            long const yshift=right_shift(y,i);
+            long const xshift=right_shift(x,i);
+
+            if (theta < 0)
+            {
+                x += yshift;
+                y -= xshift;
+                theta += *arctanptr++;
+            }
+            else
+            {
+                x -= yshift;
+                y += xshift;
+                theta -= *arctanptr++;
+            }
+        }
+        px = scale_cordic_result(x,iterations);
+        py = scale_cordic_result(y,iterations);
+    }
+
+
+    FIXED_CONSTEXPR_ARITHMETIC void perform_cordic_polarization(long& argx, long&argy,int iterations)
+    {
+        long theta=0;
+        long x = argx, y = argy;
+        long const *arctanptr = arctantab;
+        for(int i = -1; i < iterations-1; ++i)
+        {
+            long const yshift=right_shift(y,i);
+            long const xshift=right_shift(x,i);
+            if(y < 0)
+            {
+                y += xshift;
+                x -= yshift;
+                theta -= *arctanptr++;
+            }
+            else
+            {
+                y -= xshift;
+                x += yshift;
+                theta += *arctanptr++;
+            }
+        }
+        argx = scale_cordic_result(x,iterations);
+        argy = theta;
+    }
+
+    // 2/pi in Q128, split into two words
+    unsigned __int64 const two_over_pi_upper=0xA2F9836E4E441529I64;
+    unsigned __int64 const two_over_pi_lower=0xFC2757D1F534DDC0I64;
+
+    // theta=(quadrant+fraction)*pi/2, with fraction in [0,1) as Q64. Only
+    // the bottom two bits of quadrant are meaningful.
+    struct reduced_angle
+    {
+        unsigned quadrant;
+        unsigned __int64 fraction;
+    };
+
+    // Multiplies theta by 2/pi as a signed 128-bit product, so the floor
+    // of the product is the quadrant and the fraction needs no sign fix-up.
+    // Angles within [-pi,pi] only need the upper word of 2/pi; larger ones
+    // use both so the fraction stays exact to well below an ulp across the
+    // whole range.
+    template<unsigned FracBits>
+    FIXED_CONSTEXPR_ARITHMETIC reduced_angle reduce_angle(__int64 theta)
+    {
+        unsigned __int64 const sign_mask=(unsigned __int64)(theta>>63);
+        unsigned __int64 const internal_pi=fixed_pi_q61>>(61-FracBits);
+        unsigned __int64 upper=multiply_high((unsigned __int64)theta,two_over_pi_upper)-(two_over_pi_upper&sign_mask);
+        unsigned __int64 lower=(unsigned __int64)theta*two_over_pi_upper;
+        if((unsigned __int64)theta+internal_pi>2*internal_pi)
+        {
+            unsigned __int64 const carry_in=multiply_high((unsigned __int64)theta,two_over_pi_lower)-(two_over_pi_lower&sign_mask);
+            lower+=carry_in;
+            upper+=((lower<carry_in)?1:0)-(carry_in>>63);
+        }
+
+        reduced_angle const res={unsigned(upper>>FracBits),(upper<<(64-FracBits))|(lower>>FracBits)};
+        return res;
+    }
+
+    // Maps sin and cos of the fraction onto the quadrant: each quarter
+    // turn takes (s,c) to (c,-s).
+    template<typename T>
+    FIXED_CONSTEXPR_ARITHMETIC void apply_quadrant(unsigned quadrant,T& s,T& c)
+    {
+        T const swap=(s^c)&-T(quadrant&1);
+        T const negate_sin=-T((quadrant>>1)&1);
+        T const negate_cos=-T(((quadrant+1)>>1)&1);
+        s=((s^swap)^negate_sin)-negate_sin;
+        c=((c^swap)^negate_cos)-negate_cos;
+    }
+}
+
+#if defined(FIXED_TABLE_TRIG)
+
+#if !defined(FIXED_TRIG_TABLE_BITS)
+#define FIXED_TRIG_TABLE_BITS 9
+#endif
+
+#if (FIXED_TRIG_TABLE_BITS<2) || (FIXED_TRIG_TABLE_BITS>16)
+#error FIXED_TRIG_TABLE_BITS must be between 2 and 16
+#endif
+
+namespace
+{
+    unsigned const trig_table_bits=FIXED_TRIG_TABLE_BITS;
+    unsigned const trig_table_size=1u<<trig_table_bits;
+
+    // Taylor series for sin(x) (term=x, n=1) or cos(x) (term=1, n=0) in
+    // Q62, for |x|<=pi/4
+    FIXED_CONSTEXPR_ARITHMETIC __int64 trig_series(__int64 x,__int64 term,unsigned n)
+    {
+        __int64 const x_squared=multiply_q62(x,x);
+        __int64 res=term;
+        while(term)
+        {
+            term=-multiply_q62(term,x_squared)/__int64((n+1)*(n+2));
+            n+=2;
+            res+=term;
+        }
+        return res;
+    }
+
+    // sin(k*pi/2/trig_table_size) in Q62 for k=0..trig_table_size, so the
+    // cosine at k is the sine at trig_table_size-k. Built by the compiler
+    // where the helpers are constexpr and at start-up otherwise, so the
+    // size can be chosen when compiling. Tables over 2^14 intervals would
+    // exceed the compilers' default constexpr step limits.
+#if FIXED_TRIG_TABLE_BITS<=14
+#define FIXED_TRIG_TABLE_CONSTEXPR FIXED_CONSTEXPR_ARITHMETIC
+#else
+#define FIXED_TRIG_TABLE_CONSTEXPR
+#endif
+    struct quarter_sine_table
+    {
+        __int64 entries[trig_table_size+1];
+
+        FIXED_TRIG_TABLE_CONSTEXPR quarter_sine_table():
+            entries()
+        {
+            for(unsigned k=0;k<=trig_table_size/2;++k)
+            {
+                // k*pi/2/trig_table_size without overflowing pi/2 in Q62
+                unsigned __int64 const low_mask=trig_table_size-1;
+                __int64 const x=(__int64)(k*(fixed_pi_q61>>trig_table_bits)+((k*(fixed_pi_q61&low_mask))>>trig_table_bits));
+                entries[k]=trig_series(x,x,1);
+                entries[trig_table_size-k]=trig_series(x,1I64<<62,0);
+            }
+        }
+    };
+
+    FIXED_TRIG_TABLE_CONSTEXPR quarter_sine_table const quarter_sine;
+
+    template<typename StorageInt,unsigned FracBits>
+    FIXED_CONSTEXPR_ARITHMETIC void evaluate_sin_cos(reduced_angle const& angle,StorageInt& s,StorageInt& c,unsigned)
+    {
+        // position within the quarter wave as a fraction of pi/2 in Q62
+        unsigned const position_shift=62-trig_table_bits;
+        unsigned __int64 const position=angle.fraction>>2;
+        __int64 const* const table=quarter_sine.entries;
+
+#if defined(FIXED_TRIG_LINEAR)
+        // interpolate between the entries either side of x
+        unsigned index=unsigned(position>>position_shift);
+        if(index>=trig_table_size)
+        {
+            index=trig_table_size-1;
+        }
+        __int64 const t=(__int64)((position-((unsigned __int64)index<<position_shift))<<trig_table_bits);
+        __int64 sin_x=table[index]+multiply_q62(table[index+1]-table[index],t);
+        __int64 cos_x=table[trig_table_size-index]
+            +multiply_q62(table[trig_table_size-index-1]-table[trig_table_size-index],t);
+#else
+        // second order Taylor step from the nearest entry, using the cosine
+        // entry as the derivative: |d|<=pi/4/trig_table_size radians
+        unsigned const index=unsigned((position+(1I64<<(position_shift-1)))>>position_shift);
+        __int64 const d=multiply_q62((__int64)(position-((unsigned __int64)index<<position_shift)),(__int64)fixed_pi_q61);
+        __int64 const half_d_squared=multiply_q62(d,d)>>1;
+        __int64 const sin_k=table[index];
+        __int64 const cos_k=table[trig_table_size-index];
+        __int64 sin_x=sin_k+multiply_q62(cos_k,d)-multiply_q62(sin_k,half_d_squared);
+        __int64 cos_x=cos_k-multiply_q62(sin_k,d)-multiply_q62(cos_k,half_d_squared);
+#endif
+        apply_quadrant(angle.quadrant,sin_x,cos_x);
+
+        __int64 const round_bias=1I64<<(61-FracBits);
+        s=StorageInt((sin_x+round_bias)>>(62-FracBits));
+        c=StorageInt((cos_x+round_bias)>>(62-FracBits));
+    }
+}
+
+#else
+
+namespace
+{
+    // the fraction of a quarter turn as an angle in the CORDIC format
+    FIXED_CONSTEXPR_ARITHMETIC inline long to_cordic_angle(reduced_angle const& angle)
+    {
+        unsigned __int64 const x=multiply_high(angle.fraction,fixed_pi_q61);
+        return (long)((x+(1I64<<(61-cordic_shift)))>>(62-cordic_shift));
+    }
+
+    template<typename StorageInt,unsigned FracBits>
+    FIXED_CONSTEXPR_ARITHMETIC void evaluate_sin_cos(reduced_angle const& angle,StorageInt& s,StorageInt& c,unsigned iterations)
+    {
+        long x_cos=1<<cordic_shift,x_sin=0;
+
+        perform_cordic_rotation(x_cos,x_sin,to_cordic_angle(angle),clamp_cordic_iterations(iterations));
+        apply_quadrant(angle.quadrant,x_sin,x_cos);
+
+        s=from_cordic_scale<FracBits>(StorageInt(x_sin));
+        c=from_cordic_scale<FracBits>(StorageInt(x_cos));
+    }
+}
+
+#endif
+
+template<typename StorageInt,unsigned FracBits>
+FIXED_CONSTEXPR_MATH void basic_fixed<StorageInt,FracBits>::sin_cos(basic_fixed const& theta,basic_fixed* s,basic_fixed*c,unsigned iterations)
+{
+    StorageInt sin_theta=0,cos_theta=0;
+    evaluate_sin_cos<StorageInt,FracBits>(reduce_angle<FracBits>(theta.m_nVal),sin_theta,cos_theta,iterations);
+    if(s)
+    {
+        s->m_nVal=sin_theta;
+    }
+    if(c)
+    {
+        c->m_nVal=cos_theta;
+    }
+}
+
+template<typename StorageInt,unsigned FracBits>
+FIXED_CONSTEXPR_MATH void basic_fixed<StorageInt,FracBits>::sin_cos_turns(unsigned __int64 turns,basic_fixed* s,basic_fixed*c,unsigned iterations)
+{
+    reduced_angle const angle={unsigned(turns>>62),turns<<2};
+
+    StorageInt sin_theta=0,cos_theta=0;
+    evaluate_sin_cos<StorageInt,FracBits>(angle,sin_theta,cos_theta,iterations);
+    if(s)
+    {
+        s->m_nVal=sin_theta;
+    }
+    if(c)
+    {
+        c->m_nVal=cos_theta;
+    }
+}
+
+template<typename StorageInt,unsigned FracBits>
+unsigned __int64 basic_fixed<StorageInt,FracBits>::as_turns() const
+{
+    reduced_angle const angle=reduce_angle<FracBits>(m_nVal);
+    return (((unsigned __int64)angle.quadrant<<62)|(angle.fraction>>2))+((angle.fraction>>1)&1);
+}
+
+template<typename StorageInt,unsigned FracBits>
+basic_fixed<StorageInt,FracBits> basic_fixed<StorageInt,FracBits>::from_turns(unsigned __int64 turns)
+{
+    // turns as a signed fraction times 2*pi, which is fixed_pi_q61 read as Q60
+    unsigned __int64 const sign_mask=(unsigned __int64)((__int64)turns>>63);
+    unsigned __int64 const upper=multiply_high(turns,fixed_pi_q61)-(fixed_pi_q61&sign_mask);
+    return basic_fixed(internal(),StorageInt((__int64)(upper+(1I64<<(59-FracBits)))>>(60-FracBits)));
+}
+
+namespace
+{
+    // 1/360 in Q72, i.e. turns per degree
+    unsigned __int64 const turns_per_degree=0xB60B60B60B60B60BI64;
+
+    // Degrees to a Q64 fraction of a turn. The modulo by 360 degrees is
+    // exact, so whole turns vanish without error, and rounding the product
+    // makes multiples of 90 degrees land exactly on a quadrant.
+    template<typename StorageInt,unsigned FracBits>
+    unsigned __int64 degrees_to_turns(StorageInt degrees)
+    {
+        StorageInt const full_turn=StorageInt(360)<<FracBits;
+        StorageInt remainder=degrees%full_turn;
+        if(remainder<0)
+        {
+            remainder+=full_turn;
+        }
+        unsigned const shift=FracBits+8;
+        unsigned __int64 const upper=multiply_high((unsigned __int64)remainder,turns_per_degree);
+        unsigned __int64 const lower=(unsigned __int64)remainder*turns_per_degree;
+        return ((upper<<(64-shift))|(lower>>shift))+((lower>>(shift-1))&1);
+    }
+
+    // A Q64 fraction of a turn to degrees in [-180,180), rounded
+    template<typename StorageInt,unsigned FracBits>
+    StorageInt turns_to_degrees(unsigned __int64 turns)
+    {
+        unsigned __int64 const sign_mask=(unsigned __int64)((__int64)turns>>63);
+        unsigned __int64 const upper=multiply_high(turns,360)-(360&sign_mask);
+        unsigned __int64 const lower=turns*360;
+        unsigned const shift=64-FracBits;
+        StorageInt const res=StorageInt(((upper<<FracBits)|(lower>>shift))+((lower>>(shift-1))&1));
+        // just below half a turn can round up to 180, which wraps
+        return (res==(StorageInt(180)<<FracBits))?StorageInt(-res):res;
+    }
+}
+
+template<typename StorageInt,unsigned FracBits>
+void basic_fixed<StorageInt,FracBits>::sin_cos_deg(basic_fixed const& theta,basic_fixed* s,basic_fixed*c,unsigned iterations)
+{
+    sin_cos_turns(degrees_to_turns<StorageInt,FracBits>(theta.m_nVal),s,c,iterations);
+}
+
+namespace
+{
+    // Halves a point in the first quadrant until it fits the CORDIC format,
+    // returning the number of halvings
+    template<typename UnsignedInt>
+    FIXED_CONSTEXPR_ARITHMETIC unsigned to_cordic_range(UnsignedInt& a,UnsignedInt& b)
+    {
+        unsigned right_shift=0;
+        unsigned const max_value=1U<<cordic_shift;
+
+        while((a>=max_value) || (b>=max_value))
+        {
+            ++right_shift;
+            a>>=1;
+            b>>=1;
+        }
+        return right_shift;
+    }
+
+    // CORDIC vectoring for a point in the first quadrant. The magnitude is
+    // in the scale of a and b; the angle is in [0,pi/2] in the CORDIC
+    // format.
+    template<typename UnsignedInt>
+    FIXED_CONSTEXPR_ARITHMETIC long polarize(UnsignedInt a,UnsignedInt b,UnsignedInt* r,unsigned iterations)
+    {
+        unsigned const right_shift=to_cordic_range(a,b);
+        long xtemp=(long)a;
+        long ytemp=(long)b;
+        perform_cordic_polarization(xtemp,ytemp,clamp_cordic_iterations(iterations));
+        *r=UnsignedInt(xtemp)<<right_shift;
+        return ytemp;
+    }
+
+    // The first quadrant angle of (|x|,|y|) moved to the quadrant of (x,y)
+    template<typename StorageInt,unsigned FracBits>
+    FIXED_CONSTEXPR_ARITHMETIC StorageInt to_polar_quadrant(StorageInt theta,bool negative_x,bool negative_y)
+    {
+        typedef fixed_constants<StorageInt,FracBits> constants;
+        if(negative_x && negative_y)
+        {
+            return theta-constants::internal_pi;
+        }
+        else if(negative_x)
+        {
+            return constants::internal_pi-theta;
+        }
+        else if(negative_y)
+        {
+            return -theta;
+        }
+        return theta;
+    }
+}
+
+template<typename StorageInt,unsigned FracBits>
+FIXED_CONSTEXPR_MATH void basic_fixed<StorageInt,FracBits>::to_polar(basic_fixed const& x,basic_fixed const& y,basic_fixed* r,basic_fixed*theta,unsigned iterations)
+{
+    bool const negative_x=x.m_nVal<0;
+    bool const negative_y=y.m_nVal<0;
+    
+    unsigned_storage_type a=negative_x?0-unsigned_storage_type(x.m_nVal):unsigned_storage_type(x.m_nVal);
+    unsigned_storage_type b=negative_y?0-unsigned_storage_type(y.m_nVal):unsigned_storage_type(y.m_nVal);
+
+    unsigned_storage_type magnitude=0;
+    long const angle=polarize(a,b,&magnitude,iterations);
+    r->m_nVal=StorageInt(magnitude);
+    theta->m_nVal=to_polar_quadrant<StorageInt,FracBits>(from_cordic_scale<FracBits>(StorageInt(angle)),negative_x,negative_y);
+}
+
+template<typename StorageInt,unsigned FracBits>
+FIXED_CONSTEXPR_MATH void basic_fixed<StorageInt,FracBits>::to_polar_turns(basic_fixed const& x,basic_fixed const& y,basic_fixed* r,unsigned __int64* turns,unsigned iterations)
+{
+    bool const negative_x=x.m_nVal<0;
+    bool const negative_y=y.m_nVal<0;
+
+    unsigned_storage_type a=negative_x?0-unsigned_storage_type(x.m_nVal):unsigned_storage_type(x.m_nVal);
+    unsigned_storage_type b=negative_y?0-unsigned_storage_type(y.m_nVal):unsigned_storage_type(y.m_nVal);
+
+    unsigned_storage_type magnitude=0;
+    __int64 const angle=polarize(a,b,&magnitude,iterations);
+    r->m_nVal=StorageInt(magnitude);
+
+    // angle*(2/pi) counts quarter turns in Q(cordic_shift+64); keep Q64
+    // turns. The angle can come out a hair below zero.
+    unsigned const turn_shift=cordic_shift+2;
+    unsigned __int64 const sign_mask=(unsigned __int64)(angle>>63);
+    unsigned __int64 const upper=multiply_high((unsigned __int64)angle,two_over_pi_upper)-(two_over_pi_upper&sign_mask);
+    unsigned __int64 const lower=angle*two_over_pi_upper;
+    unsigned __int64 const half_turn=(unsigned __int64)1<<63;
+    unsigned __int64 res=((upper<<(64-turn_shift))|(lower>>turn_shift))+((lower>>(turn_shift-1))&1);
+
+    // the wrap at a full turn takes care of the quadrants
+    if(negative_x && negative_y)
+    {
+        res+=half_turn;
+    }
+    else if(negative_x)
+    {
+        res=half_turn-res;
+    }
+    else if(negative_y)
+    {
+        res=0-res;
+    }
+    *turns=res;
+}
+
+namespace
+{
+    // atan(2^-i) in Q62
+    __int64 const arctan_q62[]={
+        0x3243F6A8885A308DI64, 0x1DAC670561BB4F69I64, 0xFADBAFC96406EB1I64,
+        0x7F56EA6AB0BDB72I64, 0x3FEAB76E59FBD39I64, 0x1FFD55BBA97624BI64,
+        0xFFFAAADDDB94D6I64, 0x7FFF5556EEEA5DI64, 0x3FFFEAAAB7776EI64,
+        0x1FFFFD5555BBBCI64, 0xFFFFFAAAAADDEI64, 0x7FFFFF555556FI64,
+        0x3FFFFFEAAAAABI64, 0x1FFFFFFD55555I64, 0xFFFFFFFAAAABI64,
+        0x7FFFFFFF5555I64, 0x3FFFFFFFEAABI64,
+    };
+
+    // Steps after which the residual angle is small enough to finish with
+    // one division: atan(r)=r-r^3/3 and r^3/3 is below 2^-48
+    int const vectoring_steps=17;
+
+    // atan(b/a) in [0,pi/2] in Q62 for a and b not both zero, in any
+    // common scale. Only the angle is tracked, so the CORDIC gain never
+    // needs correcting, and the inputs are normalized up as well as down so
+    // small vectors keep their precision. With fewer steps than
+    // vectoring_steps the error is about 2^-steps.
+    __int64 vectoring_angle(unsigned __int64 a,unsigned __int64 b,int steps)
+    {
+        // reflect into the first octant: atan(b/a)=pi/2-atan(a/b)
+        bool const swapped=b>a;
+        if(swapped)
+        {
+            unsigned __int64 const temp=a;
+            a=b;
+            b=temp;
+        }
+        if(!a)
+        {
+            return 0;
+        }
+
+        // a in [2^60,2^61) leaves room for the gain of 1.65 and the sqrt(2)
+        int const shift=int(count_leading_zeros(a))-3;
+        __int64 x=(__int64)right_shift(a,-shift);
+        __int64 y=(__int64)right_shift(b,-shift);
+        __int64 theta=0;
+        for(int i=0;i<steps;++i)
+        {
+            // rotate towards the x axis, with the direction as a mask
+            // because it is unpredictable
+            __int64 const direction=y>>63;
+            __int64 const xshift=x>>i;
+            __int64 const yshift=y>>i;
+            x+=(yshift^direction)-direction;
+            y-=(xshift^direction)-direction;
+            theta+=(arctan_q62[i]^direction)-direction;
+        }
+        if(steps>=vectoring_steps)
+        {
+            // |y|<2^47 here, and y/x in Q48 is plenty
+            theta+=(__int64)((unsigned __int64)((__int64)((unsigned __int64)y<<16)/(x>>32))<<14);
+        }
+        return swapped?(__int64)fixed_pi_q61-theta:theta;
+    }
+
+    // An angle in Q62 to the format, rounded
+    template<typename StorageInt,unsigned FracBits>
+    StorageInt angle_from_q62(__int64 angle)
+    {
+        return StorageInt((angle+(1I64<<(61-FracBits)))>>(62-FracBits));
+    }
+}
+
+template<typename StorageInt,unsigned FracBits>
+basic_fixed<StorageInt,FracBits> basic_fixed<StorageInt,FracBits>::atan(unsigned iterations) const
+{
+    int const steps=clamp_cordic_iterations(iterations);
+    unsigned __int64 const magnitude=(m_nVal<0)?0-unsigned_storage_type(m_nVal):unsigned_storage_type(m_nVal);
+    __int64 const angle=vectoring_angle((unsigned __int64)resolution,magnitude,
+        (steps<vectoring_steps)?steps:vectoring_steps);
+    StorageInt const res=angle_from_q62<StorageInt,FracBits>(angle);
+    return basic_fixed(internal(),(m_nVal<0)?-res:res);
+}
+
+template<typename StorageInt,unsigned FracBits>
+basic_fixed<StorageInt,FracBits> basic_fixed<StorageInt,FracBits>::atan2(basic_fixed const& y,basic_fixed const& x)
+{
+    bool const negative_x=x.m_nVal<0;
+    bool const negative_y=y.m_nVal<0;
+    unsigned __int64 const a=negative_x?0-unsigned_storage_type(x.m_nVal):unsigned_storage_type(x.m_nVal);
+    unsigned __int64 const b=negative_y?0-unsigned_storage_type(y.m_nVal):unsigned_storage_type(y.m_nVal);
+
+    // quadrant fix-ups in Q61, where pi fits
+    __int64 theta=vectoring_angle(a,b,vectoring_steps)>>1;
+    if(negative_x)
+    {
+        theta=(__int64)fixed_pi_q61-theta;
+    }
+    if(negative_y)
+    {
+        theta=-theta;
+    }
+    return basic_fixed(internal(),StorageInt((theta+(1I64<<(60-FracBits)))>>(61-FracBits)));
+}
+
+namespace
+{
+    // atan2(y,x) from vectoring_angle() as a Q64 fraction of a turn, which
+    // turns_to_degrees() reads as [-180,180)
+    inline unsigned __int64 vectoring_turns(unsigned __int64 a,unsigned __int64 b,bool negative_x,bool negative_y,int steps)
+    {
+        // angle*(2/pi) is Q126 quarter turns, so the upper half is Q64 turns.
+        // The angle can come out a hair below zero.
+        __int64 const angle=vectoring_angle(a,b,steps);
+        unsigned __int64 const sign_mask=(unsigned __int64)(angle>>63);
+        unsigned __int64 const lower=(unsigned __int64)angle*two_over_pi_upper;
+        unsigned __int64 res=multiply_high((unsigned __int64)angle,two_over_pi_upper)-(two_over_pi_upper&sign_mask)+(lower>>63);
+
+        // the wrap at a full turn takes care of the quadrants
+        unsigned __int64 const half_turn=(unsigned __int64)1<<63;
+        if(negative_x && negative_y)
+        {
+            res+=half_turn;
+        }
+        else if(negative_x)
+        {
+            res=half_turn-res;
+        }
+        else if(negative_y)
+        {
+            res=0-res;
+        }
+        return res;
+    }
+}
+
+template<typename StorageInt,unsigned FracBits>
+void basic_fixed<StorageInt,FracBits>::to_polar_deg(basic_fixed const& x,basic_fixed const& y,basic_fixed* r,basic_fixed*theta,unsigned iterations)
+{
+    bool const negative_x=x.m_nVal<0;
+    bool const negative_y=y.m_nVal<0;
+    unsigned_storage_type a=negative_x?0-unsigned_storage_type(x.m_nVal):unsigned_storage_type(x.m_nVal);
+    unsigned_storage_type b=negative_y?0-unsigned_storage_type(y.m_nVal):unsigned_storage_type(y.m_nVal);
+
+    // the magnitude from the CORDIC, the angle as atan2_deg() finds it
+    unsigned_storage_type magnitude=0;
+    polarize(a,b,&magnitude,iterations);
+    r->m_nVal=StorageInt(magnitude);
+    int const steps=clamp_cordic_iterations(iterations);
+    unsigned __int64 const turns=vectoring_turns(a,b,negative_x,negative_y,(steps<vectoring_steps)?steps:vectoring_steps);
+    theta->m_nVal=turns_to_degrees<StorageInt,FracBits>(turns);
+}
+
+template<typename StorageInt,unsigned FracBits>
+basic_fixed<StorageInt,FracBits> basic_fixed<StorageInt,FracBits>::atan2_deg(basic_fixed const& y,basic_fixed const& x)
+{
+    bool const negative_x=x.m_nVal<0;
+    bool const negative_y=y.m_nVal<0;
+    unsigned __int64 const a=negative_x?0-unsigned_storage_type(x.m_nVal):unsigned_storage_type(x.m_nVal);
+    unsigned __int64 const b=negative_y?0-unsigned_storage_type(y.m_nVal):unsigned_storage_type(y.m_nVal);
+
+    unsigned __int64 const turns=vectoring_turns(a,b,negative_x,negative_y,vectoring_steps);
+    return basic_fixed(internal(),turns_to_degrees<StorageInt,FracBits>(turns));
+}
+
+template<typename StorageInt,unsigned FracBits>
+basic_fixed<StorageInt,FracBits> basic_fixed<StorageInt,FracBits>::asin() const
+{
+    return inverse_sine(false);
+}
+
+template<typename StorageInt,unsigned FracBits>
+basic_fixed<StorageInt,FracBits> basic_fixed<StorageInt,FracBits>::acos() const
+{
+    return inverse_sine(true);
+}
+
+template<typename StorageInt,unsigned FracBits>
+basic_fixed<StorageInt,FracBits> basic_fixed<StorageInt,FracBits>::inverse_sine(bool cosine) const
+{
+    bool const negative=m_nVal<0;
+    unsigned __int64 const magnitude=negative?0-unsigned_storage_type(m_nVal):unsigned_storage_type(m_nVal);
+
+    // asin(x)=atan(x/sqrt(1-x^2)) and acos(x)=pi/2-asin(x). With x in Q62,
+    // 1-x^2 is exact because x has only FracBits fractional bits.
+    __int64 angle=(__int64)fixed_pi_q61;
+    if(magnitude<(unsigned __int64)resolution)
+    {
+        unsigned __int64 const x=magnitude<<(62-FracBits);
+        unsigned __int64 const one_minus_x_squared=(1I64<<62)-((multiply_high(x,x)<<2)|((x*x)>>62));
+        unsigned __int64 const root=square_root<__int64>(one_minus_x_squared,62);
+        angle=vectoring_angle(root,x,vectoring_steps);
+    }
+
+    // in Q61 so that acos() has room for pi
+    __int64 res=angle>>1;
+    if(negative)
+    {
+        res=-res;
+    }
+    if(cosine)
+    {
+        res=(__int64)(fixed_pi_q61>>1)-res;
+    }
+    return basic_fixed(internal(),StorageInt((res+(1I64<<(60-FracBits)))>>(61-FracBits)));
+}
+
+#if !defined(FIXED_NO_FLOATING_POINT)
+namespace
+{
+    unsigned const max_minimax_degree=16;
+
+    // Solves the n equations held as rows of n coefficients and a right
+    // hand side, by Gaussian elimination with partial pivoting
+    inline void solve_linear_system(double (*rows)[max_minimax_degree+3],unsigned n,double* solution)
+    {
+        for(unsigned column=0;column<n;++column)
+        {
+            unsigned pivot=column;
+            for(unsigned row=column+1;row<n;++row)
+            {
+                if(std::fabs(rows[row][column])>std::fabs(rows[pivot][column]))
+                {
+                    pivot=row;
+                }
+            }
+            for(unsigned k=column;k<=n;++k)
+            {
+                double const temp=rows[column][k];
+                rows[column][k]=rows[pivot][k];
+                rows[pivot][k]=temp;
+            }
+            for(unsigned row=column+1;row<n;++row)
+            {
+                double const factor=rows[row][column]/rows[column][column];
+                for(unsigned k=column;k<=n;++k)
+                {
+                    rows[row][k]-=factor*rows[column][k];
+                }
+            }
+        }
+        for(unsigned row=n;row-->0;)
+        {
+            double sum=rows[row][n];
+            for(unsigned k=row+1;k<n;++k)
+            {
+                sum-=rows[row][k]*solution[k];
+            }
+            solution[row]=sum/rows[row][row];
+        }
+    }
+
+    // Error of the polynomial in t at t, where x=centre+half_width*t
+    inline double minimax_error(double (*function)(double),double const* coefficients,unsigned degree,
+                                double centre,double half_width,double t)
+    {
+        double p=coefficients[degree];
+        for(unsigned k=degree;k-->0;)
+        {
+            p=p*t+coefficients[k];
+        }
+        return function(centre+half_width*t)-p;
+    }
+}
+
+template<typename StorageInt,unsigned FracBits>
+double basic_fixed<StorageInt,FracBits>::fit_minimax(double (*function)(double),basic_fixed const& lower,basic_fixed const& upper,unsigned degree,fixed_coefficient* coefficients)
+{
+    if((degree>max_minimax_degree) || !(lower<upper))
+    {
+        return -1;
+    }
+    unsigned const points=degree+2;
+    unsigned const grid=256*points;
+    // fit over t in [-1,1], which keeps the system well conditioned
+    double const centre=(lower.as_double()+upper.as_double())/2;
+    double const half_width=(upper.as_double()-lower.as_double())/2;
+    double const pi=3.14159265358979323846;
+
+    double reference[max_minimax_degree+2];
+    for(unsigned i=0;i<points;++i)
+    {
+        reference[i]=-std::cos(pi*i/(points-1));
+    }
+
+    double fit[max_minimax_degree+2]={};
+    double best_fit[max_minimax_degree+1]={};
+    double best_error=HUGE_VAL;
+    for(unsigned iteration=0;iteration<50;++iteration)
+    {
+        // p(t_i)+(-1)^i*E=f(t_i) at each reference point
+        double rows[max_minimax_degree+2][max_minimax_degree+3];
+        for(unsigned i=0;i<points;++i)
+        {
+            double power=1;
+            for(unsigned k=0;k<=degree;++k)
+            {
+                rows[i][k]=power;
+                power*=reference[i];
+            }
+            rows[i][degree+1]=(i&1)?-1:1;
+            rows[i][points]=function(centre+half_width*reference[i]);
+        }
+        solve_linear_system(rows,points,fit);
+        double const levelled_error=std::fabs(fit[degree+1]);
+
+        // the extremum of each run of errors of one sign, located on the
+        // grid and refined by ternary search within a grid step either side
+        double extrema[4*max_minimax_degree+8];
+        double extreme_errors[4*max_minimax_degree+8];
+        unsigned count=0;
+        double max_error=0;
+        double const step=2.0/grid;
+        for(unsigned g=0;g<=grid;)
+        {
+            double const first=minimax_error(function,fit,degree,centre,half_width,-1+g*step);
+            bool const positive=first>=0;
+            unsigned best=g;
+            double run_error=std::fabs(first);
+            for(++g;g<=grid;++g)
+            {
+                double const error=minimax_error(function,fit,degree,centre,half_width,-1+g*step);
+                if((error>=0)!=positive)
+                {
+                    break;
+                }
+                if(std::fabs(error)>run_error)
+                {
+                    best=g;
+                    run_error=std::fabs(error);
+                }
+            }
+            double left=(best>0)?-1+(best-1)*step:-1;
+            double right=(best<grid)?-1+(best+1)*step:1;
+            for(unsigned k=0;k<40;++k)
+            {
+                double const a=left+(right-left)/3;
+                double const b=right-(right-left)/3;
+                if(std::fabs(minimax_error(function,fit,degree,centre,half_width,a))
+                   <std::fabs(minimax_error(function,fit,degree,centre,half_width,b)))
+                {
+                    left=a;
+                }
+                else
+                {
+                    right=b;
+                }
+            }
+            double t=(left+right)/2;
+            double error=std::fabs(minimax_error(function,fit,degree,centre,half_width,t));
+            if(error<run_error)
+            {
+                t=-1+best*step;
+                error=run_error;
+            }
+            if(count<4*max_minimax_degree+8)
+            {
+                extrema[count]=t;
+                extreme_errors[count]=error;
+                ++count;
+            }
+            if(error>max_error)
+            {
+                max_error=error;
+            }
+        }
+        if(max_error<best_error)
+        {
+            best_error=max_error;
+            for(unsigned k=0;k<=degree;++k)
+            {
+                best_fit[k]=fit[k];
+            }
+        }
+        // fewer alternations than points means the error is down to
+        // rounding noise
+        if(count<points || (max_error-levelled_error)<=max_error*1e-6)
+        {
+            break;
+        }
+        // drop the smallest extrema, an end one alone or an interior one
+        // with its smaller neighbour so the signs still alternate
+        while(count>points)
+        {
+            unsigned smallest=0;
+            for(unsigned i=1;i<count;++i)
+            {
+                if(extreme_errors[i]<extreme_errors[smallest])
+                {
+                    smallest=i;
+                }
+            }
+            unsigned removed=1;
+            if(smallest>0 && smallest<count-1)
+            {
+                if(count==points+1)
+                {
+                    smallest=(extreme_errors[0]<extreme_errors[count-1])?0:count-1;
+                }
+                else
+                {
+                    if(extreme_errors[smallest+1]<extreme_errors[smallest-1])
+                    {
+                        removed=2;
+                    }
+                    else
+                    {
+                        --smallest;
+                        removed=2;
+                    }
+                }
+            }
+            for(unsigned i=smallest;i+removed<count;++i)
+            {
+                extrema[i]=extrema[i+removed];
+                extreme_errors[i]=extreme_errors[i+removed];
+            }
+            count-=removed;
+        }
+        for(unsigned i=0;i<points;++i)
+        {
+            reference[i]=extrema[i];
+        }
+    }
+
+    // expand p((x-centre)/half_width) into powers of x
+    double power_coefficients[max_minimax_degree+1]={};
+    double const scale=1/half_width;
+    double const offset=-centre/half_width;
+    for(unsigned k=degree+1;k-->0;)
+    {
+        for(unsigned j=degree-k;j-->0;)
+        {
+            power_coefficients[j+1]+=power_coefficients[j]*scale;
+            power_coefficients[j]*=offset;
+        }
+        power_coefficients[0]+=best_fit[k];
+    }
+
+    // each partial sum is bounded by its coefficient plus x times the
+    // bound above, and gets the most fractional bits that leave it a spare
+    // bit in 64
+    double const range=std::fabs(lower.as_double())>std::fabs(upper.as_double())?std::fabs(lower.as_double()):std::fabs(upper.as_double());
+    double bound=0;
+    int frac_bits=62;
+    for(unsigned k=degree+1;k-->0;)
+    {
+        bound=std::fabs(power_coefficients[k])+range*bound;
+        int exponent=0;
+        std::frexp(bound,&exponent);
+        int bits=(bound>0)?62-exponent:62;
+        if(k<degree && bits>frac_bits+int(FracBits))
+        {
+            bits=frac_bits+int(FracBits);
+        }
+        frac_bits=(bits<0)?0:((bits>62)?62:bits);
+        coefficients[k].value=(__int64)std::floor(std::ldexp(power_coefficients[k],frac_bits)+0.5);
+        coefficients[k].frac_bits=unsigned(frac_bits);
+    }
+    return best_error;
+}
+#endif
+
+#if defined(FIXED_DISPATCH_BATCH)
+namespace
+{
+    // cpuid for leaf and subleaf: eax, ebx, ecx and edx
+    inline void read_cpuid(unsigned leaf,unsigned subleaf,unsigned* registers)
+    {
+#if defined(_MSC_VER)
+        int values[4];
+        __cpuidex(values,int(leaf),int(subleaf));
+        for(unsigned i=0;i<4;++i)
+        {
+            registers[i]=unsigned(values[i]);
+        }
+#else
+        __cpuid_count(leaf,subleaf,registers[0],registers[1],registers[2],registers[3]);
+#endif
+    }
+
+    // The register state the operating system saves, from xgetbv
+    inline unsigned __int64 read_enabled_state()
+    {
+#if defined(_MSC_VER)
+        return _xgetbv(0);
+#else
+        unsigned lower,upper;
+        __asm__("xgetbv":"=a"(lower),"=d"(upper):"c"(0));
+        return ((unsigned __int64)upper<<32)|lower;
+#endif
+    }
+
+    // The best level the processor has and the operating system saves the
+    // registers of: AVX needs the SSE and AVX state, AVX-512 the opmask and
+    // upper ZMM state as well
+    inline fixed_batch_level supported_batch_level()
+    {
+        unsigned registers[4];
+        read_cpuid(0,0,registers);
+        unsigned const max_leaf=registers[0];
+        read_cpuid(1,0,registers);
+        if(!(registers[2]&(1U<<20)))
+        {
+            return fixed_batch_portable;
+        }
+        bool const has_avx=(registers[2]&(1U<<27)) && (registers[2]&(1U<<28));
+        if(!has_avx || (max_leaf<7))
+        {
+            return fixed_batch_sse42;
+        }
+        unsigned __int64 const state=read_enabled_state();
+        if((state&0x6)!=0x6)
+        {
+            return fixed_batch_sse42;
+        }
+        read_cpuid(7,0,registers);
+        if(!(registers[1]&(1U<<5)))
+        {
+            return fixed_batch_sse42;
+        }
+        if((registers[1]&(1U<<16)) && ((state&0xe0)==0xe0))
+        {
+            return fixed_batch_avx512;
+        }
+        return fixed_batch_avx2;
+    }
+
+    // The supported level, lowered to the one FIXED_BATCH_LEVEL names
+    inline fixed_batch_level select_batch_level()
+    {
+        fixed_batch_level const supported=supported_batch_level();
+        char const* const requested=std::getenv("FIXED_BATCH_LEVEL");
+        if(requested)
+        {
+            for(int level=fixed_batch_portable;level<supported;++level)
+            {
+                if(!std::strcmp(requested,fixed_batch_level_name(fixed_batch_level(level))))
+                {
+                    return fixed_batch_level(level);
+                }
+            }
+        }
+        return supported;
+    }
+}
+#endif
+
+FIXED_INLINE fixed_batch_level fixed_batch_level_in_use()
+{
+#if defined(FIXED_DISPATCH_BATCH)
+    static fixed_batch_level const level=select_batch_level();
+    return level;
+#else
+    return fixed_batch_portable;
+#endif
+}
+
+FIXED_INLINE char const* fixed_batch_level_name(fixed_batch_level level)
+{
+    switch(level)
+    {
+    case fixed_batch_sse42:
+        return "sse42";
+    case fixed_batch_avx2:
+        return "avx2";
+    case fixed_batch_avx512:
+        return "avx512";
+    default:
+        return "portable";
+    }
+}
+
+namespace
+{
+    // Batch kernels process whole vectors of raw values and return how many
+    // leading elements they did, leaving the rest to the scalar operators.
+    // Formats without kernels do none.
+    template<typename StorageInt,unsigned FracBits>
+    struct portable_batch
+    {
+        static std::size_t multiply(StorageInt const*,StorageInt const*,StorageInt*,std::size_t)
+        {
+            return 0;
+        }
+        static std::size_t add(StorageInt const*,StorageInt const*,StorageInt*,std::size_t)
+        {
+            return 0;
+        }
+        static std::size_t subtract(StorageInt const*,StorageInt const*,StorageInt*,std::size_t)
+        {
+            return 0;
+        }
+        static std::size_t scale(StorageInt const*,int,StorageInt*,std::size_t)
+        {
+            return 0;
+        }
+        static std::size_t abs(StorageInt const*,StorageInt*,std::size_t)
+        {
+            return 0;
+        }
+        static std::size_t min(StorageInt const*,StorageInt const*,StorageInt*,std::size_t)
+        {
+            return 0;
+        }
+        static std::size_t max(StorageInt const*,StorageInt const*,StorageInt*,std::size_t)
+        {
+            return 0;
+        }
+        static std::size_t clamp(StorageInt const*,StorageInt,StorageInt,StorageInt*,std::size_t)
+        {
+            return 0;
+        }
+    };
+
+#if defined(FIXED_DISPATCH_BATCH)
+    // x*factor modulo 2^64, given the halves of the sign-extended factor
+    inline FIXED_TARGET("sse4.2") __m128i scale_sse42(__m128i x,__m128i factor_lower,__m128i factor_upper)
+    {
+        __m128i const cross=_mm_add_epi64(_mm_mul_epu32(_mm_srli_epi64(x,32),factor_lower),_mm_mul_epu32(x,factor_upper));
+        return _mm_add_epi64(_mm_mul_epu32(x,factor_lower),_mm_slli_epi64(cross,32));
+    }
+
+    inline FIXED_TARGET("sse4.2") __m128i min_sse42(__m128i a,__m128i b)
+    {
+        return _mm_blendv_epi8(a,b,_mm_cmpgt_epi64(a,b));
+    }
+
+    inline FIXED_TARGET("sse4.2") __m128i max_sse42(__m128i a,__m128i b)
+    {
+        return _mm_blendv_epi8(b,a,_mm_cmpgt_epi64(a,b));
+    }
+
+    template<unsigned FracBits>
+    struct sse42_batch
+    {
+        static unsigned const lanes=2;
+
+        // two lanes of 32-bit partial products are slower than the scalar
+        // 64-bit multiply
+        static FIXED_TARGET("sse4.2") std::size_t multiply(__int64 const*,__int64 const*,__int64*,std::size_t)
+        {
+            return 0;
+        }
+
+        static FIXED_TARGET("sse4.2") std::size_t add(__int64 const* a,__int64 const* b,__int64* res,std::size_t count)
+        {
+            std::size_t i=0;
+            for(;i+lanes<=count;i+=lanes)
+            {
+                _mm_storeu_si128((__m128i*)(res+i),_mm_add_epi64(_mm_loadu_si128((__m128i const*)(a+i)),_mm_loadu_si128((__m128i const*)(b+i))));
+            }
+            return i;
+        }
+
+        static FIXED_TARGET("sse4.2") std::size_t subtract(__int64 const* a,__int64 const* b,__int64* res,std::size_t count)
+        {
+            std::size_t i=0;
+            for(;i+lanes<=count;i+=lanes)
+            {
+                _mm_storeu_si128((__m128i*)(res+i),_mm_sub_epi64(_mm_loadu_si128((__m128i const*)(a+i)),_mm_loadu_si128((__m128i const*)(b+i))));
+            }
+            return i;
+        }
+
+        static FIXED_TARGET("sse4.2") std::size_t scale(__int64 const* a,int factor,__int64* res,std::size_t count)
+        {
+            __m128i const factor_lower=_mm_set1_epi64x((unsigned)factor);
+            __m128i const factor_upper=_mm_set1_epi64x((factor<0)?0xffffffff:0);
+            std::size_t i=0;
+            for(;i+lanes<=count;i+=lanes)
+            {
+                _mm_storeu_si128((__m128i*)(res+i),scale_sse42(_mm_loadu_si128((__m128i const*)(a+i)),factor_lower,factor_upper));
+            }
+            return i;
+        }
+
+        static FIXED_TARGET("sse4.2") std::size_t abs(__int64 const* a,__int64* res,std::size_t count)
+        {
+            std::size_t i=0;
+            for(;i+lanes<=count;i+=lanes)
+            {
+                __m128i const x=_mm_loadu_si128((__m128i const*)(a+i));
+                __m128i const sign=_mm_cmpgt_epi64(_mm_setzero_si128(),x);
+                _mm_storeu_si128((__m128i*)(res+i),_mm_sub_epi64(_mm_xor_si128(x,sign),sign));
+            }
+            return i;
+        }
+
+        static FIXED_TARGET("sse4.2") std::size_t min(__int64 const* a,__int64 const* b,__int64* res,std::size_t count)
+        {
+            std::size_t i=0;
+            for(;i+lanes<=count;i+=lanes)
+            {
+                _mm_storeu_si128((__m128i*)(res+i),min_sse42(_mm_loadu_si128((__m128i const*)(a+i)),_mm_loadu_si128((__m128i const*)(b+i))));
+            }
+            return i;
+        }
+
+        static FIXED_TARGET("sse4.2") std::size_t max(__int64 const* a,__int64 const* b,__int64* res,std::size_t count)
+        {
+            std::size_t i=0;
+            for(;i+lanes<=count;i+=lanes)
+            {
+                _mm_storeu_si128((__m128i*)(res+i),max_sse42(_mm_loadu_si128((__m128i const*)(a+i)),_mm_loadu_si128((__m128i const*)(b+i))));
+            }
+            return i;
+        }
+
+        static FIXED_TARGET("sse4.2") std::size_t clamp(__int64 const* a,__int64 lower,__int64 upper,__int64* res,std::size_t count)
+        {
+            __m128i const lower_bound=_mm_set1_epi64x(lower);
+            __m128i const upper_bound=_mm_set1_epi64x(upper);
+            std::size_t i=0;
+            for(;i+lanes<=count;i+=lanes)
+            {
+                _mm_storeu_si128((__m128i*)(res+i),min_sse42(max_sse42(_mm_loadu_si128((__m128i const*)(a+i)),lower_bound),upper_bound));
+            }
+            return i;
+        }
+    };
+#endif
+
+#if defined(FIXED_DISPATCH_BATCH)
+    // The scalar multiply on four lanes: the 128-bit product of the
+    // magnitudes from 32-bit partial products, less FracBits, with the sign
+    // restored
+    template<unsigned FracBits>
+    inline FIXED_TARGET("avx2") __m256i multiply_avx2(__m256i a,__m256i b)
+    {
+        __m256i const a_sign=_mm256_cmpgt_epi64(_mm256_setzero_si256(),a);
+        __m256i const b_sign=_mm256_cmpgt_epi64(_mm256_setzero_si256(),b);
+        __m256i const x=_mm256_sub_epi64(_mm256_xor_si256(a,a_sign),a_sign);
+        __m256i const y=_mm256_sub_epi64(_mm256_xor_si256(b,b_sign),b_sign);
+        __m256i const x_upper=_mm256_srli_epi64(x,32);
+        __m256i const y_upper=_mm256_srli_epi64(y,32);
+        __m256i const round_bias=_mm256_set1_epi64x(fixed_round_multiply?(1I64<<(FracBits-1)):0);
+        __m256i const lower_mask=_mm256_set1_epi64x(0xffffffff);
+        __m256i const lower_lower=_mm256_add_epi64(_mm256_mul_epu32(x,y),round_bias);
+        __m256i const upper_lower=_mm256_mul_epu32(x_upper,y);
+        __m256i const lower_upper=_mm256_mul_epu32(x,y_upper);
+        __m256i const middle=_mm256_add_epi64(_mm256_add_epi64(_mm256_srli_epi64(lower_lower,32),_mm256_and_si256(upper_lower,lower_mask)),
+                                             _mm256_and_si256(lower_upper,lower_mask));
+        __m256i const lower=_mm256_or_si256(_mm256_and_si256(lower_lower,lower_mask),_mm256_slli_epi64(middle,32));
+        __m256i const upper=_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(x_upper,y_upper),_mm256_srli_epi64(upper_lower,32)),
+                                            _mm256_add_epi64(_mm256_srli_epi64(lower_upper,32),_mm256_srli_epi64(middle,32)));
+        __m256i const res=_mm256_or_si256(_mm256_srli_epi64(lower,FracBits),_mm256_slli_epi64(upper,64-FracBits));
+        __m256i const sign=_mm256_xor_si256(a_sign,b_sign);
+        return _mm256_sub_epi64(_mm256_xor_si256(res,sign),sign);
+    }
+
+    inline FIXED_TARGET("avx2") __m256i scale_avx2(__m256i x,__m256i factor_lower,__m256i factor_upper)
+    {
+        __m256i const cross=_mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(x,32),factor_lower),_mm256_mul_epu32(x,factor_upper));
+        return _mm256_add_epi64(_mm256_mul_epu32(x,factor_lower),_mm256_slli_epi64(cross,32));
+    }
+
+    inline FIXED_TARGET("avx2") __m256i min_avx2(__m256i a,__m256i b)
+    {
+        return _mm256_blendv_epi8(a,b,_mm256_cmpgt_epi64(a,b));
+    }
+
+    inline FIXED_TARGET("avx2") __m256i max_avx2(__m256i a,__m256i b)
+    {
+        return _mm256_blendv_epi8(b,a,_mm256_cmpgt_epi64(a,b));
+    }
+
+    template<unsigned FracBits>
+    struct avx2_batch
+    {
+        static unsigned const lanes=4;
+
+        static FIXED_TARGET("avx2") std::size_t multiply(__int64 const* a,__int64 const* b,__int64* res,std::size_t count)
+        {
+            std::size_t i=0;
+            for(;i+lanes<=count;i+=lanes)
+            {
+                _mm256_storeu_si256((__m256i*)(res+i),multiply_avx2<FracBits>(_mm256_loadu_si256((__m256i const*)(a+i)),_mm256_loadu_si256((__m256i const*)(b+i))));
+            }
+            return i;
+        }
+
+        static FIXED_TARGET("avx2") std::size_t add(__int64 const* a,__int64 const* b,__int64* res,std::size_t count)
+        {
+            std::size_t i=0;
+            for(;i+lanes<=count;i+=lanes)
+            {
+                _mm256_storeu_si256((__m256i*)(res+i),_mm256_add_epi64(_mm256_loadu_si256((__m256i const*)(a+i)),_mm256_loadu_si256((__m256i const*)(b+i))));
+            }
+            return i;
+        }
+
+        static FIXED_TARGET("avx2") std::size_t subtract(__int64 const* a,__int64 const* b,__int64* res,std::size_t count)
+        {
+            std::size_t i=0;
+            for(;i+lanes<=count;i+=lanes)
+            {
+                _mm256_storeu_si256((__m256i*)(res+i),_mm256_sub_epi64(_mm256_loadu_si256((__m256i const*)(a+i)),_mm256_loadu_si256((__m256i const*)(b+i))));
+            }
+            return i;
+        }
+
+        static FIXED_TARGET("avx2") std::size_t scale(__int64 const* a,int factor,__int64* res,std::size_t count)
+        {
+            __m256i const factor_lower=_mm256_set1_epi64x((unsigned)factor);
+            __m256i const factor_upper=_mm256_set1_epi64x((factor<0)?0xffffffff:0);
+            std::size_t i=0;
+            for(;i+lanes<=count;i+=lanes)
+            {
+                _mm256_storeu_si256((__m256i*)(res+i),scale_avx2(_mm256_loadu_si256((__m256i const*)(a+i)),factor_lower,factor_upper));
+            }
+            return i;
+        }
+
+        static FIXED_TARGET("avx2") std::size_t abs(__int64 const* a,__int64* res,std::size_t count)
+        {
+            std::size_t i=0;
+            for(;i+lanes<=count;i+=lanes)
+            {
+                __m256i const x=_mm256_loadu_si256((__m256i const*)(a+i));
+                __m256i const sign=_mm256_cmpgt_epi64(_mm256_setzero_si256(),x);
+                _mm256_storeu_si256((__m256i*)(res+i),_mm256_sub_epi64(_mm256_xor_si256(x,sign),sign));
+            }
+            return i;
+        }
+
+        static FIXED_TARGET("avx2") std::size_t min(__int64 const* a,__int64 const* b,__int64* res,std::size_t count)
+        {
+            std::size_t i=0;
+            for(;i+lanes<=count;i+=lanes)
+            {
+                _mm256_storeu_si256((__m256i*)(res+i),min_avx2(_mm256_loadu_si256((__m256i const*)(a+i)),_mm256_loadu_si256((__m256i const*)(b+i))));
+            }
+            return i;
+        }
+
+        static FIXED_TARGET("avx2") std::size_t max(__int64 const* a,__int64 const* b,__int64* res,std::size_t count)
+        {
+            std::size_t i=0;
+            for(;i+lanes<=count;i+=lanes)
+            {
+                _mm256_storeu_si256((__m256i*)(res+i),max_avx2(_mm256_loadu_si256((__m256i const*)(a+i)),_mm256_loadu_si256((__m256i const*)(b+i))));
+            }
+            return i;
+        }
+
+        static FIXED_TARGET("avx2") std::size_t clamp(__int64 const* a,__int64 lower,__int64 upper,__int64* res,std::size_t count)
+        {
+            __m256i const lower_bound=_mm256_set1_epi64x(lower);
+            __m256i const upper_bound=_mm256_set1_epi64x(upper);
+            std::size_t i=0;
+            for(;i+lanes<=count;i+=lanes)
+            {
+                _mm256_storeu_si256((__m256i*)(res+i),min_avx2(max_avx2(_mm256_loadu_si256((__m256i const*)(a+i)),lower_bound),upper_bound));
+            }
+            return i;
+        }
+    };
+#endif
+
+#if defined(FIXED_DISPATCH_BATCH)
+    // As multiply_avx2() on eight lanes, with the native abs and shifts
+    template<unsigned FracBits>
+    inline FIXED_TARGET("avx512f") __m512i multiply_avx512(__m512i a,__m512i b)
+    {
+        __m512i const x=_mm512_abs_epi64(a);
+        __m512i const y=_mm512_abs_epi64(b);
+        __m512i const x_upper=_mm512_srli_epi64(x,32);
+        __m512i const y_upper=_mm512_srli_epi64(y,32);
+        __m512i const round_bias=_mm512_set1_epi64(fixed_round_multiply?(1I64<<(FracBits-1)):0);
+        __m512i const lower_mask=_mm512_set1_epi64(0xffffffff);
+        __m512i const lower_lower=_mm512_add_epi64(_mm512_mul_epu32(x,y),round_bias);
+        __m512i const upper_lower=_mm512_mul_epu32(x_upper,y);
+        __m512i const lower_upper=_mm512_mul_epu32(x,y_upper);
+        __m512i const middle=_mm512_add_epi64(_mm512_add_epi64(_mm512_srli_epi64(lower_lower,32),_mm512_and_si512(upper_lower,lower_mask)),
+                                              _mm512_and_si512(lower_upper,lower_mask));
+        __m512i const lower=_mm512_or_si512(_mm512_and_si512(lower_lower,lower_mask),_mm512_slli_epi64(middle,32));
+        __m512i const upper=_mm512_add_epi64(_mm512_add_epi64(_mm512_mul_epu32(x_upper,y_upper),_mm512_srli_epi64(upper_lower,32)),
+                                             _mm512_add_epi64(_mm512_srli_epi64(lower_upper,32),_mm512_srli_epi64(middle,32)));
+        __m512i const res=_mm512_or_si512(_mm512_srli_epi64(lower,FracBits),_mm512_slli_epi64(upper,64-FracBits));
+        __m512i const sign=_mm512_srai_epi64(_mm512_xor_si512(a,b),63);
+        return _mm512_sub_epi64(_mm512_xor_si512(res,sign),sign);
+    }
+
+    inline FIXED_TARGET("avx512f") __m512i scale_avx512(__m512i x,__m512i factor_lower,__m512i factor_upper)
+    {
+        __m512i const cross=_mm512_add_epi64(_mm512_mul_epu32(_mm512_srli_epi64(x,32),factor_lower),_mm512_mul_epu32(x,factor_upper));
+        return _mm512_add_epi64(_mm512_mul_epu32(x,factor_lower),_mm512_slli_epi64(cross,32));
+    }
+
+    template<unsigned FracBits>
+    struct avx512_batch
+    {
+        static unsigned const lanes=8;
+
+        static FIXED_TARGET("avx512f") std::size_t multiply(__int64 const* a,__int64 const* b,__int64* res,std::size_t count)
+        {
+            std::size_t i=0;
+            for(;i+lanes<=count;i+=lanes)
+            {
+                _mm512_storeu_si512(res+i,multiply_avx512<FracBits>(_mm512_loadu_si512(a+i),_mm512_loadu_si512(b+i)));
+            }
+            return i;
+        }
+
+        static FIXED_TARGET("avx512f") std::size_t add(__int64 const* a,__int64 const* b,__int64* res,std::size_t count)
+        {
+            std::size_t i=0;
+            for(;i+lanes<=count;i+=lanes)
+            {
+                _mm512_storeu_si512(res+i,_mm512_add_epi64(_mm512_loadu_si512(a+i),_mm512_loadu_si512(b+i)));
+            }
+            return i;
+        }
+
+        static FIXED_TARGET("avx512f") std::size_t subtract(__int64 const* a,__int64 const* b,__int64* res,std::size_t count)
+        {
+            std::size_t i=0;
+            for(;i+lanes<=count;i+=lanes)
+            {
+                _mm512_storeu_si512(res+i,_mm512_sub_epi64(_mm512_loadu_si512(a+i),_mm512_loadu_si512(b+i)));
+            }
+            return i;
+        }
+
+        static FIXED_TARGET("avx512f") std::size_t scale(__int64 const* a,int factor,__int64* res,std::size_t count)
+        {
+            __m512i const factor_lower=_mm512_set1_epi64((unsigned)factor);
+            __m512i const factor_upper=_mm512_set1_epi64((factor<0)?0xffffffff:0);
+            std::size_t i=0;
+            for(;i+lanes<=count;i+=lanes)
+            {
+                _mm512_storeu_si512(res+i,scale_avx512(_mm512_loadu_si512(a+i),factor_lower,factor_upper));
+            }
+            return i;
+        }
+
+        static FIXED_TARGET("avx512f") std::size_t abs(__int64 const* a,__int64* res,std::size_t count)
+        {
+            std::size_t i=0;
+            for(;i+lanes<=count;i+=lanes)
+            {
+                _mm512_storeu_si512(res+i,_mm512_abs_epi64(_mm512_loadu_si512(a+i)));
+            }
+            return i;
+        }
+
+        static FIXED_TARGET("avx512f") std::size_t min(__int64 const* a,__int64 const* b,__int64* res,std::size_t count)
+        {
+            std::size_t i=0;
+            for(;i+lanes<=count;i+=lanes)
+            {
+                _mm512_storeu_si512(res+i,_mm512_min_epi64(_mm512_loadu_si512(a+i),_mm512_loadu_si512(b+i)));
+            }
+            return i;
+        }
+
+        static FIXED_TARGET("avx512f") std::size_t max(__int64 const* a,__int64 const* b,__int64* res,std::size_t count)
+        {
+            std::size_t i=0;
+            for(;i+lanes<=count;i+=lanes)
+            {
+                _mm512_storeu_si512(res+i,_mm512_max_epi64(_mm512_loadu_si512(a+i),_mm512_loadu_si512(b+i)));
+            }
+            return i;
+        }
+
+        static FIXED_TARGET("avx512f") std::size_t clamp(__int64 const* a,__int64 lower,__int64 upper,__int64* res,std::size_t count)
+        {
+            __m512i const lower_bound=_mm512_set1_epi64(lower);
+            __m512i const upper_bound=_mm512_set1_epi64(upper);
+            std::size_t i=0;
+            for(;i+lanes<=count;i+=lanes)
+            {
+                _mm512_storeu_si512(res+i,_mm512_min_epi64(_mm512_max_epi64(_mm512_loadu_si512(a+i),lower_bound),upper_bound));
+            }
+            return i;
+        }
+    };
+#endif
+
+    template<typename StorageInt,unsigned FracBits>
+    struct batch_kernels:
+        portable_batch<StorageInt,FracBits>
+    {};
+
+#if defined(FIXED_DISPATCH_BATCH)
+    // The kernels of fixed_batch_level_in_use(). Each pointer starts out at
+    // a stub that binds them all and calls through, so the choice is made on
+    // first use and does not depend on the order of static initialization.
+    // Racing first calls store the same values.
+    template<unsigned FracBits>
+    struct batch_kernels<__int64,FracBits>
+    {
+        static std::size_t (*multiply)(__int64 const*,__int64 const*,__int64*,std::size_t);
+        static std::size_t (*add)(__int64 const*,__int64 const*,__int64*,std::size_t);
+        static std::size_t (*subtract)(__int64 const*,__int64 const*,__int64*,std::size_t);
+        static std::size_t (*scale)(__int64 const*,int,__int64*,std::size_t);
+        static std::size_t (*abs)(__int64 const*,__int64*,std::size_t);
+        static std::size_t (*min)(__int64 const*,__int64 const*,__int64*,std::size_t);
+        static std::size_t (*max)(__int64 const*,__int64 const*,__int64*,std::size_t);
+        static std::size_t (*clamp)(__int64 const*,__int64,__int64,__int64*,std::size_t);
+
+        template<typename Kernels>
+        static void use()
+        {
+            multiply=&Kernels::multiply;
+            add=&Kernels::add;
+            subtract=&Kernels::subtract;
+            scale=&Kernels::scale;
+            abs=&Kernels::abs;
+            min=&Kernels::min;
+            max=&Kernels::max;
+            clamp=&Kernels::clamp;
+        }
+
+        static void bind()
+        {
+            switch(fixed_batch_level_in_use())
+            {
+            case fixed_batch_avx512:
+                use<avx512_batch<FracBits> >();
+                break;
+            case fixed_batch_avx2:
+                use<avx2_batch<FracBits> >();
+                break;
+            case fixed_batch_sse42:
+                use<sse42_batch<FracBits> >();
+                break;
+            default:
+                use<portable_batch<__int64,FracBits> >();
+                break;
+            }
+        }
+
+        static std::size_t bind_multiply(__int64 const* a,__int64 const* b,__int64* res,std::size_t count)
+        {
+            bind();
+            return multiply(a,b,res,count);
+        }
+        static std::size_t bind_add(__int64 const* a,__int64 const* b,__int64* res,std::size_t count)
+        {
+            bind();
+            return add(a,b,res,count);
+        }
+        static std::size_t bind_subtract(__int64 const* a,__int64 const* b,__int64* res,std::size_t count)
+        {
+            bind();
+            return subtract(a,b,res,count);
+        }
+        static std::size_t bind_scale(__int64 const* a,int factor,__int64* res,std::size_t count)
+        {
+            bind();
+            return scale(a,factor,res,count);
+        }
+        static std::size_t bind_abs(__int64 const* a,__int64* res,std::size_t count)
+        {
+            bind();
+            return abs(a,res,count);
+        }
+        static std::size_t bind_min(__int64 const* a,__int64 const* b,__int64* res,std::size_t count)
+        {
+            bind();
+            return min(a,b,res,count);
+        }
+        static std::size_t bind_max(__int64 const* a,__int64 const* b,__int64* res,std::size_t count)
+        {
+            bind();
+            return max(a,b,res,count);
+        }
+        static std::size_t bind_clamp(__int64 const* a,__int64 lower,__int64 upper,__int64* res,std::size_t count)
+        {
+            bind();
+            return clamp(a,lower,upper,res,count);
+        }
+    };
+
+    template<unsigned FracBits>
+    std::size_t (*batch_kernels<__int64,FracBits>::multiply)(__int64 const*,__int64 const*,__int64*,std::size_t)=&batch_kernels<__int64,FracBits>::bind_multiply;
+    template<unsigned FracBits>
+    std::size_t (*batch_kernels<__int64,FracBits>::add)(__int64 const*,__int64 const*,__int64*,std::size_t)=&batch_kernels<__int64,FracBits>::bind_add;
+    template<unsigned FracBits>
+    std::size_t (*batch_kernels<__int64,FracBits>::subtract)(__int64 const*,__int64 const*,__int64*,std::size_t)=&batch_kernels<__int64,FracBits>::bind_subtract;
+    template<unsigned FracBits>
+    std::size_t (*batch_kernels<__int64,FracBits>::scale)(__int64 const*,int,__int64*,std::size_t)=&batch_kernels<__int64,FracBits>::bind_scale;
+    template<unsigned FracBits>
+    std::size_t (*batch_kernels<__int64,FracBits>::abs)(__int64 const*,__int64*,std::size_t)=&batch_kernels<__int64,FracBits>::bind_abs;
+    template<unsigned FracBits>
+    std::size_t (*batch_kernels<__int64,FracBits>::min)(__int64 const*,__int64 const*,__int64*,std::size_t)=&batch_kernels<__int64,FracBits>::bind_min;
+    template<unsigned FracBits>
+    std::size_t (*batch_kernels<__int64,FracBits>::max)(__int64 const*,__int64 const*,__int64*,std::size_t)=&batch_kernels<__int64,FracBits>::bind_max;
+    template<unsigned FracBits>
+    std::size_t (*batch_kernels<__int64,FracBits>::clamp)(__int64 const*,__int64,__int64,__int64*,std::size_t)=&batch_kernels<__int64,FracBits>::bind_clamp;
+#endif
+
+    // the representation of an array of values; a value holds nothing but
+    // its StorageInt
+    template<typename StorageInt,unsigned FracBits>
+    StorageInt const* raw_values(basic_fixed<StorageInt,FracBits> const* values)
+    {
+        return reinterpret_cast<StorageInt const*>(values);
+    }
+    template<typename StorageInt,unsigned FracBits>
+    StorageInt* raw_values(basic_fixed<StorageInt,FracBits>* values)
+    {
+        return reinterpret_cast<StorageInt*>(values);
+    }
+}
+
+template<typename StorageInt,unsigned FracBits>
+void fixed_mul(basic_fixed<StorageInt,FracBits> const* a,basic_fixed<StorageInt,FracBits> const* b,basic_fixed<StorageInt,FracBits>* res,std::size_t count)
+{
+    std::size_t i=batch_kernels<StorageInt,FracBits>::multiply(raw_values(a),raw_values(b),raw_values(res),count);
+    for(;i<count;++i)
+    {
+        res[i]=a[i]*b[i];
+    }
+}
+
+template<typename StorageInt,unsigned FracBits>
+void fixed_add(basic_fixed<StorageInt,FracBits> const* a,basic_fixed<StorageInt,FracBits> const* b,basic_fixed<StorageInt,FracBits>* res,std::size_t count)
+{
+    std::size_t i=batch_kernels<StorageInt,FracBits>::add(raw_values(a),raw_values(b),raw_values(res),count);
+    for(;i<count;++i)
+    {
+        res[i]=a[i]+b[i];
+    }
+}
+
+template<typename StorageInt,unsigned FracBits>
+void fixed_sub(basic_fixed<StorageInt,FracBits> const* a,basic_fixed<StorageInt,FracBits> const* b,basic_fixed<StorageInt,FracBits>* res,std::size_t count)
+{
+    std::size_t i=batch_kernels<StorageInt,FracBits>::subtract(raw_values(a),raw_values(b),raw_values(res),count);
+    for(;i<count;++i)
+    {
+        res[i]=a[i]-b[i];
+    }
+}
+
+template<typename StorageInt,unsigned FracBits>
+void fixed_scale(basic_fixed<StorageInt,FracBits> const* a,int factor,basic_fixed<StorageInt,FracBits>* res,std::size_t count)
+{
+    std::size_t i=batch_kernels<StorageInt,FracBits>::scale(raw_values(a),factor,raw_values(res),count);
+    for(;i<count;++i)
+    {
+        res[i]=a[i]*factor;
+    }
+}
+
+template<typename StorageInt,unsigned FracBits>
+void fixed_abs(basic_fixed<StorageInt,FracBits> const* a,basic_fixed<StorageInt,FracBits>* res,std::size_t count)
+{
+    std::size_t i=batch_kernels<StorageInt,FracBits>::abs(raw_values(a),raw_values(res),count);
+    for(;i<count;++i)
+    {
+        res[i]=a[i].abs();
+    }
+}
+
+template<typename StorageInt,unsigned FracBits>
+void fixed_minimum(basic_fixed<StorageInt,FracBits> const* a,basic_fixed<StorageInt,FracBits> const* b,basic_fixed<StorageInt,FracBits>* res,std::size_t count)
+{
+    std::size_t i=batch_kernels<StorageInt,FracBits>::min(raw_values(a),raw_values(b),raw_values(res),count);
+    for(;i<count;++i)
+    {
+        res[i]=(a[i]>b[i])?b[i]:a[i];
+    }
+}
+
+template<typename StorageInt,unsigned FracBits>
+void fixed_maximum(basic_fixed<StorageInt,FracBits> const* a,basic_fixed<StorageInt,FracBits> const* b,basic_fixed<StorageInt,FracBits>* res,std::size_t count)
+{
+    std::size_t i=batch_kernels<StorageInt,FracBits>::max(raw_values(a),raw_values(b),raw_values(res),count);
+    for(;i<count;++i)
+    {
+        res[i]=(a[i]>b[i])?a[i]:b[i];
+    }
+}
+
+template<typename StorageInt,unsigned FracBits>
+void fixed_clamp(basic_fixed<StorageInt,FracBits> const* a,basic_fixed<StorageInt,FracBits> const& lower,basic_fixed<StorageInt,FracBits> const& upper,basic_fixed<StorageInt,FracBits>* res,std::size_t count)
+{
+    std::size_t i=batch_kernels<StorageInt,FracBits>::clamp(raw_values(a),*raw_values(&lower),*raw_values(&upper),raw_values(res),count);
+    for(;i<count;++i)
+    {
+        basic_fixed<StorageInt,FracBits> const val=(a[i]>lower)?a[i]:lower;
+        res[i]=(val>upper)?upper:val;
+    }
+}
+
+namespace
+{
+    // CORDIC kernels work in place on values in the CORDIC format, which
+    // fit 32-bit lanes, and return how many leading values they did
+    struct portable_cordic
+    {
+        static std::size_t rotate(int*,int*,int const*,std::size_t,int)
+        {
+            return 0;
+        }
+        static std::size_t polarize(int*,int*,std::size_t,int)
+        {
+            return 0;
+        }
+    };
+
+#if defined(FIXED_DISPATCH_BATCH)
+    // CORDIC steps on four lanes of 32 bits: the direction of each step is
+    // a sign mask, which negates the updates by xor and subtraction
+    inline FIXED_TARGET("sse4.2") __m128i negate_where_sse42(__m128i x,__m128i mask)
+    {
+        return _mm_sub_epi32(_mm_xor_si128(x,mask),mask);
+    }
+
+    // scale_cordic_result() on each lane: the 64-bit products of the even
+    // and odd lanes, shifted down by 31
+    inline FIXED_TARGET("sse4.2") __m128i scale_cordic_sse42(__m128i x,int iterations)
+    {
+        __m128i const factor=_mm_set1_epi32(cordic_scale_factor[iterations-1]);
+        __m128i const lower_mask=_mm_set1_epi64x(0xffffffff);
+        __m128i const even=_mm_srli_epi64(_mm_mul_epi32(x,factor),31);
+        __m128i const odd=_mm_slli_epi64(_mm_mul_epi32(_mm_srli_epi64(x,32),factor),1);
+        return _mm_or_si128(_mm_and_si128(even,lower_mask),_mm_andnot_si128(lower_mask,odd));
+    }
+
+    struct sse42_cordic
+    {
+        static unsigned const lanes=4;
+
+        static FIXED_TARGET("sse4.2") std::size_t rotate(int* px,int* py,int const* ptheta,std::size_t count,int iterations)
+        {
+            std::size_t i=0;
+            for(;i+lanes<=count;i+=lanes)
+            {
+                __m128i x=_mm_loadu_si128((__m128i const*)(px+i));
+                __m128i y=_mm_loadu_si128((__m128i const*)(py+i));
+                __m128i theta=_mm_loadu_si128((__m128i const*)(ptheta+i));
+                for(int step=-1;step<iterations-1;++step)
+                {
+                    __m128i const yshift=(step<0)?_mm_slli_epi32(y,1):_mm_sra_epi32(y,_mm_cvtsi32_si128(step));
+                    __m128i const xshift=(step<0)?_mm_slli_epi32(x,1):_mm_sra_epi32(x,_mm_cvtsi32_si128(step));
+                    __m128i const negative=_mm_srai_epi32(theta,31);
+                    x=_mm_sub_epi32(x,negate_where_sse42(yshift,negative));
+                    y=_mm_add_epi32(y,negate_where_sse42(xshift,negative));
+                    theta=_mm_sub_epi32(theta,negate_where_sse42(_mm_set1_epi32(int(arctantab[step+1])),negative));
+                }
+                _mm_storeu_si128((__m128i*)(px+i),scale_cordic_sse42(x,iterations));
+                _mm_storeu_si128((__m128i*)(py+i),scale_cordic_sse42(y,iterations));
+            }
+            return i;
+        }
+
+        static FIXED_TARGET("sse4.2") std::size_t polarize(int* px,int* py,std::size_t count,int iterations)
+        {
+            std::size_t i=0;
+            for(;i+lanes<=count;i+=lanes)
+            {
+                __m128i x=_mm_loadu_si128((__m128i const*)(px+i));
+                __m128i y=_mm_loadu_si128((__m128i const*)(py+i));
+                __m128i theta=_mm_setzero_si128();
+                for(int step=-1;step<iterations-1;++step)
+                {
+                    __m128i const yshift=(step<0)?_mm_slli_epi32(y,1):_mm_sra_epi32(y,_mm_cvtsi32_si128(step));
+                    __m128i const xshift=(step<0)?_mm_slli_epi32(x,1):_mm_sra_epi32(x,_mm_cvtsi32_si128(step));
+                    __m128i const negative=_mm_srai_epi32(y,31);
+                    y=_mm_sub_epi32(y,negate_where_sse42(xshift,negative));
+                    x=_mm_add_epi32(x,negate_where_sse42(yshift,negative));
+                    theta=_mm_add_epi32(theta,negate_where_sse42(_mm_set1_epi32(int(arctantab[step+1])),negative));
+                }
+                _mm_storeu_si128((__m128i*)(px+i),scale_cordic_sse42(x,iterations));
+                _mm_storeu_si128((__m128i*)(py+i),theta);
+            }
+            return i;
+        }
+    };
+#endif
+
+#if defined(FIXED_DISPATCH_BATCH)
+    // As the SSE4.2 CORDIC on eight lanes
+    inline FIXED_TARGET("avx2") __m256i negate_where_avx2(__m256i x,__m256i mask)
+    {
+        return _mm256_sub_epi32(_mm256_xor_si256(x,mask),mask);
+    }
+
+    // scale_cordic_result() on each lane: the 64-bit products of the even
+    // and odd lanes, shifted down by 31
+    inline FIXED_TARGET("avx2") __m256i scale_cordic_avx2(__m256i x,int iterations)
+    {
+        __m256i const factor=_mm256_set1_epi32(cordic_scale_factor[iterations-1]);
+        __m256i const lower_mask=_mm256_set1_epi64x(0xffffffff);
+        __m256i const even=_mm256_srli_epi64(_mm256_mul_epi32(x,factor),31);
+        __m256i const odd=_mm256_slli_epi64(_mm256_mul_epi32(_mm256_srli_epi64(x,32),factor),1);
+        return _mm256_or_si256(_mm256_and_si256(even,lower_mask),_mm256_andnot_si256(lower_mask,odd));
+    }
+
+    struct avx2_cordic
+    {
+        static unsigned const lanes=8;
+
+        static FIXED_TARGET("avx2") std::size_t rotate(int* px,int* py,int const* ptheta,std::size_t count,int iterations)
+        {
+            std::size_t i=0;
+            for(;i+lanes<=count;i+=lanes)
+            {
+                __m256i x=_mm256_loadu_si256((__m256i const*)(px+i));
+                __m256i y=_mm256_loadu_si256((__m256i const*)(py+i));
+                __m256i theta=_mm256_loadu_si256((__m256i const*)(ptheta+i));
+                for(int step=-1;step<iterations-1;++step)
+                {
+                    __m256i const yshift=(step<0)?_mm256_slli_epi32(y,1):_mm256_sra_epi32(y,_mm_cvtsi32_si128(step));
+                    __m256i const xshift=(step<0)?_mm256_slli_epi32(x,1):_mm256_sra_epi32(x,_mm_cvtsi32_si128(step));
+                    __m256i const negative=_mm256_srai_epi32(theta,31);
+                    x=_mm256_sub_epi32(x,negate_where_avx2(yshift,negative));
+                    y=_mm256_add_epi32(y,negate_where_avx2(xshift,negative));
+                    theta=_mm256_sub_epi32(theta,negate_where_avx2(_mm256_set1_epi32(int(arctantab[step+1])),negative));
+                }
+                _mm256_storeu_si256((__m256i*)(px+i),scale_cordic_avx2(x,iterations));
+                _mm256_storeu_si256((__m256i*)(py+i),scale_cordic_avx2(y,iterations));
+            }
+            return i;
+        }
+
+        static FIXED_TARGET("avx2") std::size_t polarize(int* px,int* py,std::size_t count,int iterations)
+        {
+            std::size_t i=0;
+            for(;i+lanes<=count;i+=lanes)
+            {
+                __m256i x=_mm256_loadu_si256((__m256i const*)(px+i));
+                __m256i y=_mm256_loadu_si256((__m256i const*)(py+i));
+                __m256i theta=_mm256_setzero_si256();
+                for(int step=-1;step<iterations-1;++step)
+                {
+                    __m256i const yshift=(step<0)?_mm256_slli_epi32(y,1):_mm256_sra_epi32(y,_mm_cvtsi32_si128(step));
+                    __m256i const xshift=(step<0)?_mm256_slli_epi32(x,1):_mm256_sra_epi32(x,_mm_cvtsi32_si128(step));
+                    __m256i const negative=_mm256_srai_epi32(y,31);
+                    y=_mm256_sub_epi32(y,negate_where_avx2(xshift,negative));
+                    x=_mm256_add_epi32(x,negate_where_avx2(yshift,negative));
+                    theta=_mm256_add_epi32(theta,negate_where_avx2(_mm256_set1_epi32(int(arctantab[step+1])),negative));
+                }
+                _mm256_storeu_si256((__m256i*)(px+i),scale_cordic_avx2(x,iterations));
+                _mm256_storeu_si256((__m256i*)(py+i),theta);
+            }
+            return i;
+        }
+    };
+#endif
+
+#if defined(FIXED_DISPATCH_BATCH)
+    // As the SSE4.2 CORDIC on sixteen lanes
+    inline FIXED_TARGET("avx512f") __m512i negate_where_avx512(__m512i x,__m512i mask)
+    {
+        return _mm512_sub_epi32(_mm512_xor_si512(x,mask),mask);
+    }
+
+    // scale_cordic_result() on each lane: the 64-bit products of the even
+    // and odd lanes, shifted down by 31
+    inline FIXED_TARGET("avx512f") __m512i scale_cordic_avx512(__m512i x,int iterations)
+    {
+        __m512i const factor=_mm512_set1_epi32(cordic_scale_factor[iterations-1]);
+        __m512i const lower_mask=_mm512_set1_epi64(0xffffffff);
+        __m512i const even=_mm512_srli_epi64(_mm512_mul_epi32(x,factor),31);
+        __m512i const odd=_mm512_slli_epi64(_mm512_mul_epi32(_mm512_srli_epi64(x,32),factor),1);
+        return _mm512_or_si512(_mm512_and_si512(even,lower_mask),_mm512_andnot_si512(lower_mask,odd));
+    }
+
+    struct avx512_cordic
+    {
+        static unsigned const lanes=16;
+
+        static FIXED_TARGET("avx512f") std::size_t rotate(int* px,int* py,int const* ptheta,std::size_t count,int iterations)
+        {
+            std::size_t i=0;
+            for(;i+lanes<=count;i+=lanes)
+            {
+                __m512i x=_mm512_loadu_si512(px+i);
+                __m512i y=_mm512_loadu_si512(py+i);
+                __m512i theta=_mm512_loadu_si512(ptheta+i);
+                for(int step=-1;step<iterations-1;++step)
+                {
+                    __m512i const yshift=(step<0)?_mm512_slli_epi32(y,1):_mm512_sra_epi32(y,_mm_cvtsi32_si128(step));
+                    __m512i const xshift=(step<0)?_mm512_slli_epi32(x,1):_mm512_sra_epi32(x,_mm_cvtsi32_si128(step));
+                    __m512i const negative=_mm512_srai_epi32(theta,31);
+                    x=_mm512_sub_epi32(x,negate_where_avx512(yshift,negative));
+                    y=_mm512_add_epi32(y,negate_where_avx512(xshift,negative));
+                    theta=_mm512_sub_epi32(theta,negate_where_avx512(_mm512_set1_epi32(int(arctantab[step+1])),negative));
+                }
+                _mm512_storeu_si512(px+i,scale_cordic_avx512(x,iterations));
+                _mm512_storeu_si512(py+i,scale_cordic_avx512(y,iterations));
+            }
+            return i;
+        }
+
+        static FIXED_TARGET("avx512f") std::size_t polarize(int* px,int* py,std::size_t count,int iterations)
+        {
+            std::size_t i=0;
+            for(;i+lanes<=count;i+=lanes)
+            {
+                __m512i x=_mm512_loadu_si512(px+i);
+                __m512i y=_mm512_loadu_si512(py+i);
+                __m512i theta=_mm512_setzero_si512();
+                for(int step=-1;step<iterations-1;++step)
+                {
+                    __m512i const yshift=(step<0)?_mm512_slli_epi32(y,1):_mm512_sra_epi32(y,_mm_cvtsi32_si128(step));
+                    __m512i const xshift=(step<0)?_mm512_slli_epi32(x,1):_mm512_sra_epi32(x,_mm_cvtsi32_si128(step));
+                    __m512i const negative=_mm512_srai_epi32(y,31);
+                    y=_mm512_sub_epi32(y,negate_where_avx512(xshift,negative));
+                    x=_mm512_add_epi32(x,negate_where_avx512(yshift,negative));
+                    theta=_mm512_add_epi32(theta,negate_where_avx512(_mm512_set1_epi32(int(arctantab[step+1])),negative));
+                }
+                _mm512_storeu_si512(px+i,scale_cordic_avx512(x,iterations));
+                _mm512_storeu_si512(py+i,theta);
+            }
+            return i;
+        }
+    };
+#endif
+
+#if defined(FIXED_DISPATCH_BATCH)
+    // Bound on first use like batch_kernels<__int64,FracBits>
+    struct cordic_kernels
+    {
+        static std::size_t (*rotate)(int*,int*,int const*,std::size_t,int);
+        static std::size_t (*polarize)(int*,int*,std::size_t,int);
+
+        template<typename Kernels>
+        static void use()
+        {
+            rotate=&Kernels::rotate;
+            polarize=&Kernels::polarize;
+        }
+
+        static void bind()
+        {
+            switch(fixed_batch_level_in_use())
+            {
+            case fixed_batch_avx512:
+                use<avx512_cordic>();
+                break;
+            case fixed_batch_avx2:
+                use<avx2_cordic>();
+                break;
+            case fixed_batch_sse42:
+                use<sse42_cordic>();
+                break;
+            default:
+                use<portable_cordic>();
+                break;
+            }
+        }
+
+        static std::size_t bind_rotate(int* x,int* y,int const* theta,std::size_t count,int iterations)
+        {
+            bind();
+            return rotate(x,y,theta,count,iterations);
+        }
+        static std::size_t bind_polarize(int* x,int* y,std::size_t count,int iterations)
+        {
+            bind();
+            return polarize(x,y,count,iterations);
+        }
+    };
+
+    std::size_t (*cordic_kernels::rotate)(int*,int*,int const*,std::size_t,int)=&cordic_kernels::bind_rotate;
+    std::size_t (*cordic_kernels::polarize)(int*,int*,std::size_t,int)=&cordic_kernels::bind_polarize;
+#else
+    typedef portable_cordic cordic_kernels;
+#endif
+
+    // The batch functions reduce and place values one at a time exactly as
+    // sin_cos() and to_polar() do, and run the CORDIC steps in between on
+    // blocks of this many
+    unsigned const cordic_block_size=64;
+
+    inline void rotate_cordic_block(int* x,int* y,int const* theta,std::size_t count,int iterations)
+    {
+        for(std::size_t i=cordic_kernels::rotate(x,y,theta,count,iterations);i<count;++i)
+        {
+            long x_cos=x[i],x_sin=y[i];
+            perform_cordic_rotation(x_cos,x_sin,theta[i],iterations);
+            x[i]=int(x_cos);
+            y[i]=int(x_sin);
+        }
+    }
+
+    inline void polarize_cordic_block(int* x,int* y,std::size_t count,int iterations)
+    {
+        for(std::size_t i=cordic_kernels::polarize(x,y,count,iterations);i<count;++i)
+        {
+            long xtemp=x[i],ytemp=y[i];
+            perform_cordic_polarization(xtemp,ytemp,iterations);
+            x[i]=int(xtemp);
+            y[i]=int(ytemp);
+        }
+    }
+}
+
+template<typename StorageInt,unsigned FracBits>
+void basic_fixed<StorageInt,FracBits>::sin_cos_batch(basic_fixed const* theta,basic_fixed* s,basic_fixed* c,std::size_t count,unsigned iterations)
+{
+#if defined(FIXED_TABLE_TRIG)
+    for(std::size_t i=0;i<count;++i)
+    {
+        basic_fixed const angle=theta[i];
+        sin_cos(angle,s?s+i:0,c?c+i:0,iterations);
+    }
+#else
+    int const steps=clamp_cordic_iterations(iterations);
+    unsigned quadrant[cordic_block_size];
+    int x[cordic_block_size],y[cordic_block_size],angle[cordic_block_size];
+    for(std::size_t start=0;start<count;start+=cordic_block_size)
+    {
+        std::size_t const block=((count-start)<cordic_block_size)?(count-start):cordic_block_size;
+        for(std::size_t i=0;i<block;++i)
+        {
+            reduced_angle const reduced=reduce_angle<FracBits>(theta[start+i].m_nVal);
+            quadrant[i]=reduced.quadrant;
+            angle[i]=int(to_cordic_angle(reduced));
+            x[i]=1<<cordic_shift;
+            y[i]=0;
+        }
+        rotate_cordic_block(x,y,angle,block,steps);
+        for(std::size_t i=0;i<block;++i)
+        {
+            long x_sin=y[i],x_cos=x[i];
+            apply_quadrant(quadrant[i],x_sin,x_cos);
+            if(s)
+            {
+                s[start+i].m_nVal=from_cordic_scale<FracBits>(StorageInt(x_sin));
+            }
+            if(c)
+            {
+                c[start+i].m_nVal=from_cordic_scale<FracBits>(StorageInt(x_cos));
+            }
+        }
+    }
+#endif
+}
+
+template<typename StorageInt,unsigned FracBits>
+void basic_fixed<StorageInt,FracBits>::to_polar_batch(basic_fixed const* x,basic_fixed const* y,basic_fixed* r,basic_fixed* theta,std::size_t count,unsigned iterations)
+{
+    int const steps=clamp_cordic_iterations(iterations);
+    bool negative_x[cordic_block_size],negative_y[cordic_block_size];
+    unsigned right_shift[cordic_block_size];
+    int a[cordic_block_size],b[cordic_block_size];
+    for(std::size_t start=0;start<count;start+=cordic_block_size)
+    {
+        std::size_t const block=((count-start)<cordic_block_size)?(count-start):cordic_block_size;
+        for(std::size_t i=0;i<block;++i)
+        {
+            negative_x[i]=x[start+i].m_nVal<0;
+            negative_y[i]=y[start+i].m_nVal<0;
+            unsigned_storage_type x_magnitude=negative_x[i]?0-unsigned_storage_type(x[start+i].m_nVal):unsigned_storage_type(x[start+i].m_nVal);
+            unsigned_storage_type y_magnitude=negative_y[i]?0-unsigned_storage_type(y[start+i].m_nVal):unsigned_storage_type(y[start+i].m_nVal);
+            right_shift[i]=to_cordic_range(x_magnitude,y_magnitude);
+            a[i]=int(x_magnitude);
+            b[i]=int(y_magnitude);
+        }
+        polarize_cordic_block(a,b,block,steps);
+        for(std::size_t i=0;i<block;++i)
+        {
+            r[start+i].m_nVal=StorageInt(unsigned_storage_type(a[i])<<right_shift[i]);
+            theta[start+i].m_nVal=to_polar_quadrant<StorageInt,FracBits>(from_cordic_scale<FracBits>(StorageInt(b[i])),negative_x[i],negative_y[i]);
+        }
+    }
+}
+
+namespace
+{
+#if !defined(FIXED_NO_FLOATING_POINT)
+    // x rounded to an integer as mode says. floor(x) and the fraction above
+    // it are exact for any double.
+    inline double round_double(double x,fixed_rounding mode)
+    {
+        if(mode==fixed_round_truncate)
+        {
+            return (x<0)?std::ceil(x):std::floor(x);
+        }
+        double const lower=std::floor(x);
+        if(mode==fixed_round_floor)
+        {
+            return lower;
+        }
+        double const fraction=x-lower;
+        if((fraction>0.5) || ((fraction==0.5) && (std::fmod(lower,2.0)!=0)))
+        {
+            return lower+1;
+        }
+        return lower;
+    }
+
+    // A double to the representation of a value, rounding, saturating, and
+    // taking NaN to zero. Values well in range round in integers: the
+    // fraction left by truncation is exact.
+    template<typename StorageInt,unsigned FracBits>
+    StorageInt double_to_storage(double x,fixed_rounding mode)
+    {
+        typedef fixed_storage_traits<StorageInt> traits;
+        typedef typename traits::unsigned_type unsigned_type;
+        StorageInt const min_value=-traits::max_value-1;
+        double const scaled=x*double(unsigned_type(1)<<FracBits);
+        double const half_range=-double(min_value/2);
+        if((scaled<half_range) && (scaled>-half_range))
+        {
+            StorageInt const res=StorageInt(scaled);
+            double const fraction=scaled-double(res);
+            if(mode==fixed_round_floor)
+            {
+                return res-(fraction<0);
+            }
+            if(mode==fixed_round_nearest_even)
+            {
+                int const odd=int(res&1);
+                return res+((fraction>0.5)|((fraction==0.5)&odd))-((fraction<-0.5)|((fraction==-0.5)&odd));
+            }
+            return res;
+        }
+        double const rounded=round_double(scaled,mode);
+        if(rounded>=-double(min_value))
+        {
+            return traits::max_value;
+        }
+        if(rounded<double(min_value))
+        {
+            return min_value;
+        }
+        if(rounded!=rounded)
+        {
+            return 0;
+        }
+        return StorageInt(rounded);
+    }
+#endif
+
+    // An integer to the representation of a value, saturating
+    template<typename StorageInt,unsigned FracBits>
+    StorageInt integer_to_storage(__int64 x)
+    {
+        typedef fixed_storage_traits<StorageInt> traits;
+        typedef typename traits::unsigned_type unsigned_type;
+        StorageInt const min_value=-traits::max_value-1;
+        if(x>(traits::max_value>>FracBits))
+        {
+            return traits::max_value;
+        }
+        if(x<(min_value>>FracBits))
+        {
+            return min_value;
+        }
+        return StorageInt(unsigned_type(x)<<FracBits);
+    }
+
+    // The representation of a value rounded to an integer as mode says and
+    // saturated to [lower,upper]. The rounding bias goes on the fraction,
+    // where it cannot overflow, and whatever carries out rounds up.
+    template<typename StorageInt,unsigned FracBits>
+    __int64 storage_to_integer(StorageInt x,fixed_rounding mode,__int64 lower,__int64 upper)
+    {
+        typedef typename fixed_storage_traits<StorageInt>::unsigned_type unsigned_type;
+        unsigned_type const mask=(unsigned_type(1)<<FracBits)-1;
+        __int64 res=x>>FracBits;
+        unsigned_type bias=0;
+        if(mode==fixed_round_truncate)
+        {
+            bias=(x<0)?mask:0;
+        }
+        else if(mode==fixed_round_nearest_even)
+        {
+            bias=(mask>>1)+unsigned_type(res&1);
+        }
+        res+=__int64(((unsigned_type(x)&mask)+bias)>>FracBits);
+        return (res<lower)?lower:((res>upper)?upper:res);
+    }
+
+    // Conversion kernels, like the batch kernels, return how many leading
+    // values they did
+    template<typename StorageInt,unsigned FracBits>
+    struct portable_convert
+    {
+        static std::size_t from_int32(int const*,StorageInt*,std::size_t)
+        {
+            return 0;
+        }
+        static std::size_t from_int16(short const*,StorageInt*,std::size_t)
+        {
+            return 0;
+        }
+        static std::size_t to_int32(StorageInt const*,int*,std::size_t,fixed_rounding)
+        {
+            return 0;
+        }
+        static std::size_t to_int16(StorageInt const*,short*,std::size_t,fixed_rounding)
+        {
+            return 0;
+        }
+#if !defined(FIXED_NO_FLOATING_POINT)
+        static std::size_t from_double(double const*,StorageInt*,std::size_t,fixed_rounding)
+        {
+            return 0;
+        }
+        static std::size_t from_float(float const*,StorageInt*,std::size_t,fixed_rounding)
+        {
+            return 0;
+        }
+        static std::size_t to_double(StorageInt const*,double*,std::size_t)
+        {
+            return 0;
+        }
+        static std::size_t to_float(StorageInt const*,float*,std::size_t)
+        {
+            return 0;
+        }
+#endif
+    };
+
+#if defined(FIXED_DISPATCH_BATCH)
+    // Four values of any of the integer types in 64-bit lanes; stores
+    // narrow lanes already in range
+    inline FIXED_TARGET("avx2") __m256i load_lanes_avx2(__int64 const* p)
+    {
+        return _mm256_loadu_si256((__m256i const*)p);
+    }
+    inline FIXED_TARGET("avx2") __m256i load_lanes_avx2(int const* p)
+    {
+        return _mm256_cvtepi32_epi64(_mm_loadu_si128((__m128i const*)p));
+    }
+    inline FIXED_TARGET("avx2") __m256i load_lanes_avx2(short const* p)
+    {
+        return _mm256_cvtepi16_epi64(_mm_loadl_epi64((__m128i const*)p));
+    }
+    inline FIXED_TARGET("avx2") void store_lanes_avx2(__int64* p,__m256i x)
+    {
+        _mm256_storeu_si256((__m256i*)p,x);
+    }
+    inline FIXED_TARGET("avx2") __m128i narrow_lanes_avx2(__m256i x)
+    {
+        return _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(x,_mm256_setr_epi32(0,2,4,6,0,2,4,6)));
+    }
+    inline FIXED_TARGET("avx2") void store_lanes_avx2(int* p,__m256i x)
+    {
+        _mm_storeu_si128((__m128i*)p,narrow_lanes_avx2(x));
+    }
+    inline FIXED_TARGET("avx2") void store_lanes_avx2(short* p,__m256i x)
+    {
+        __m128i const narrow=narrow_lanes_avx2(x);
+        _mm_storel_epi64((__m128i*)p,_mm_packs_epi32(narrow,narrow));
+    }
+
+#if !defined(FIXED_NO_FLOATING_POINT)
+    // Integral doubles below 2^51 in magnitude to 64-bit lanes, exactly
+    inline FIXED_TARGET("avx2") __m256i integral_to_lanes_avx2(__m256d x)
+    {
+        __m256d const magic=_mm256_set1_pd(6755399441055744.0);
+        return _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(x,magic)),_mm256_castpd_si256(magic));
+    }
+
+    // 64-bit lanes to the nearest doubles, as a scalar conversion rounds:
+    // the top 16 bits scaled by 2^48 and the rest are both exact, so their
+    // sum rounds once
+    inline FIXED_TARGET("avx2") __m256d lanes_to_double_avx2(__m256i x)
+    {
+        __m256i const upper=_mm256_blend_epi16(_mm256_srai_epi32(x,16),_mm256_setzero_si256(),0x33);
+        __m256d const upper_magic=_mm256_set1_pd(442721857769029238784.0);
+        __m256d const both_magic=_mm256_set1_pd(442726361368656609280.0);
+        __m256i const lower=_mm256_blend_epi16(x,_mm256_castpd_si256(_mm256_set1_pd(4503599627370496.0)),0x88);
+        __m256d const high=_mm256_sub_pd(_mm256_castsi256_pd(_mm256_add_epi64(upper,_mm256_castpd_si256(upper_magic))),both_magic);
+        return _mm256_add_pd(high,_mm256_castsi256_pd(lower));
+    }
+#endif
+
+    // x/2^FracBits rounded as Mode says, for x already clamped to integers
+    // that fit the result, so adding the rounding bias cannot overflow and
+    // the low 32 bits of a logical shift are those of the arithmetic one
+    template<unsigned FracBits,fixed_rounding Mode>
+    inline FIXED_TARGET("avx2") __m256i round_lanes_avx2(__m256i x)
+    {
+        if(Mode==fixed_round_truncate)
+        {
+            __m256i const sign=_mm256_cmpgt_epi64(_mm256_setzero_si256(),x);
+            x=_mm256_add_epi64(x,_mm256_and_si256(sign,_mm256_set1_epi64x((1I64<<FracBits)-1)));
+        }
+        else if(Mode==fixed_round_nearest_even)
+        {
+            __m256i const odd=_mm256_and_si256(_mm256_srli_epi64(x,FracBits),_mm256_set1_epi64x(1));
+            x=_mm256_add_epi64(x,_mm256_add_epi64(odd,_mm256_set1_epi64x((1I64<<(FracBits-1))-1)));
+        }
+        return _mm256_srli_epi64(x,FracBits);
+    }
+
+    // AVX2 conversions on four values at a time, for both storage types.
+    // Doubles go through the exact 2^51 conversion above, so vectors with
+    // a value outside that range, or NaN, are done one value at a time.
+    template<typename StorageInt,unsigned FracBits>
+    struct avx2_convert
+    {
+        typedef fixed_storage_traits<StorageInt> traits;
+        static unsigned const lanes=4;
+
+#if !defined(FIXED_NO_FLOATING_POINT)
+        template<int Rounding>
+        static FIXED_TARGET("avx2") std::size_t from_doubles(double const* in,StorageInt* out,std::size_t count,fixed_rounding mode)
+        {
+            __m256d const scale=_mm256_set1_pd(double(1I64<<FracBits));
+            __m256d const limit=_mm256_set1_pd((traits::bits==64)?2251799813685248.0:2147483648.0);
+            __m256d const magnitude_mask=_mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffffI64));
+            std::size_t i=0;
+            for(;i+lanes<=count;i+=lanes)
+            {
+                __m256d const rounded=_mm256_round_pd(_mm256_mul_pd(_mm256_loadu_pd(in+i),scale),Rounding|_MM_FROUND_NO_EXC);
+                if(_mm256_movemask_pd(_mm256_cmp_pd(_mm256_and_pd(rounded,magnitude_mask),limit,_CMP_LT_OQ))==0xf)
+                {
+                    store_lanes_avx2(out+i,integral_to_lanes_avx2(rounded));
+                }
+                else
+                {
+                    for(unsigned j=0;j<lanes;++j)
+                    {
+                        out[i+j]=double_to_storage<StorageInt,FracBits>(in[i+j],mode);
+                    }
+                }
+            }
+            return i;
+        }
+
+        template<int Rounding>
+        static FIXED_TARGET("avx2") std::size_t from_floats(float const* in,StorageInt* out,std::size_t count,fixed_rounding mode)
+        {
+            __m256d const scale=_mm256_set1_pd(double(1I64<<FracBits));
+            __m256d const limit=_mm256_set1_pd((traits::bits==64)?2251799813685248.0:2147483648.0);
+            __m256d const magnitude_mask=_mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffffI64));
+            std::size_t i=0;
+            for(;i+lanes<=count;i+=lanes)
+            {
+                __m256d const rounded=_mm256_round_pd(_mm256_mul_pd(_mm256_cvtps_pd(_mm_loadu_ps(in+i)),scale),Rounding|_MM_FROUND_NO_EXC);
+                if(_mm256_movemask_pd(_mm256_cmp_pd(_mm256_and_pd(rounded,magnitude_mask),limit,_CMP_LT_OQ))==0xf)
+                {
+                    store_lanes_avx2(out+i,integral_to_lanes_avx2(rounded));
+                }
+                else
+                {
+                    for(unsigned j=0;j<lanes;++j)
+                    {
+                        out[i+j]=double_to_storage<StorageInt,FracBits>(in[i+j],mode);
+                    }
+                }
+            }
+            return i;
+        }
+
+        static FIXED_TARGET("avx2") std::size_t from_double(double const* in,StorageInt* out,std::size_t count,fixed_rounding mode)
+        {
+            switch(mode)
+            {
+            case fixed_round_nearest_even:
+                return from_doubles<_MM_FROUND_TO_NEAREST_INT>(in,out,count,mode);
+            case fixed_round_floor:
+                return from_doubles<_MM_FROUND_TO_NEG_INF>(in,out,count,mode);
+            default:
+                return from_doubles<_MM_FROUND_TO_ZERO>(in,out,count,mode);
+            }
+        }
+
+        static FIXED_TARGET("avx2") std::size_t from_float(float const* in,StorageInt* out,std::size_t count,fixed_rounding mode)
+        {
+            switch(mode)
+            {
+            case fixed_round_nearest_even:
+                return from_floats<_MM_FROUND_TO_NEAREST_INT>(in,out,count,mode);
+            case fixed_round_floor:
+                return from_floats<_MM_FROUND_TO_NEG_INF>(in,out,count,mode);
+            default:
+                return from_floats<_MM_FROUND_TO_ZERO>(in,out,count,mode);
+            }
+        }
+
+        static FIXED_TARGET("avx2") std::size_t to_double(StorageInt const* in,double* out,std::size_t count)
+        {
+            __m256d const scale=_mm256_set1_pd(1.0/double(1I64<<FracBits));
+            std::size_t i=0;
+            for(;i+lanes<=count;i+=lanes)
+            {
+                _mm256_storeu_pd(out+i,_mm256_mul_pd(lanes_to_double_avx2(load_lanes_avx2(in+i)),scale));
+            }
+            return i;
+        }
+
+        // Through double, which is exact below 2^53, so only one rounding
+        static FIXED_TARGET("avx2") std::size_t to_float(StorageInt const* in,float* out,std::size_t count)
+        {
+            __m256d const scale=_mm256_set1_pd(1.0/double(1I64<<FracBits));
+            __m256i const upper=_mm256_set1_epi64x(1I64<<53);
+            __m256i const lower=_mm256_set1_epi64x(-(1I64<<53));
+            std::size_t i=0;
+            for(;i+lanes<=count;i+=lanes)
+            {
+                __m256i const x=load_lanes_avx2(in+i);
+                if(_mm256_testz_si256(_mm256_or_si256(_mm256_cmpgt_epi64(x,upper),_mm256_cmpgt_epi64(lower,x)),_mm256_set1_epi64x(-1)))
+                {
+                    _mm_storeu_ps(out+i,_mm256_cvtpd_ps(_mm256_mul_pd(lanes_to_double_avx2(x),scale)));
+                }
+                else
+                {
+                    for(unsigned j=0;j<lanes;++j)
+                    {
+                        out[i+j]=basic_fixed<StorageInt,FracBits>(typename basic_fixed<StorageInt,FracBits>::internal(),in[i+j]).as_float();
+                    }
+                }
+            }
+            return i;
+        }
+#endif
+
+        template<typename Integer>
+        static FIXED_TARGET("avx2") std::size_t from_integer(Integer const* in,StorageInt* out,std::size_t count)
+        {
+            StorageInt const min_value=-traits::max_value-1;
+            __m256i const upper=_mm256_set1_epi64x(traits::max_value>>FracBits);
+            __m256i const lower=_mm256_set1_epi64x(min_value>>FracBits);
+            __m256i const max_lanes=_mm256_set1_epi64x(traits::max_value);
+            __m256i const min_lanes=_mm256_set1_epi64x(min_value);
+            std::size_t i=0;
+            for(;i+lanes<=count;i+=lanes)
+            {
+                __m256i const x=load_lanes_avx2(in+i);
+                __m256i res=_mm256_slli_epi64(x,FracBits);
+                res=_mm256_blendv_epi8(res,max_lanes,_mm256_cmpgt_epi64(x,upper));
+                res=_mm256_blendv_epi8(res,min_lanes,_mm256_cmpgt_epi64(lower,x));
+                store_lanes_avx2(out+i,res);
+            }
+            return i;
+        }
+
+        static FIXED_TARGET("avx2") std::size_t from_int32(int const* in,StorageInt* out,std::size_t count)
+        {
+            return from_integer(in,out,count);
+        }
+
+        static FIXED_TARGET("avx2") std::size_t from_int16(short const* in,StorageInt* out,std::size_t count)
+        {
+            return from_integer(in,out,count);
+        }
+
+        // The clamp to the integers lower and upper saturates in every mode
+        template<fixed_rounding Mode,typename Integer>
+        static FIXED_TARGET("avx2") std::size_t to_integer(StorageInt const* in,Integer* out,std::size_t count,__int64 lower,__int64 upper)
+        {
+            __m256i const lower_bound=_mm256_set1_epi64x(lower<<FracBits);
+            __m256i const upper_bound=_mm256_set1_epi64x(upper<<FracBits);
+            std::size_t i=0;
+            for(;i+lanes<=count;i+=lanes)
+            {
+                __m256i x=load_lanes_avx2(in+i);
+                x=_mm256_blendv_epi8(x,upper_bound,_mm256_cmpgt_epi64(x,upper_bound));
+                x=_mm256_blendv_epi8(x,lower_bound,_mm256_cmpgt_epi64(lower_bound,x));
+                store_lanes_avx2(out+i,round_lanes_avx2<FracBits,Mode>(x));
+            }
+            return i;
+        }
+
+        template<typename Integer>
+        static FIXED_TARGET("avx2") std::size_t to_integer(StorageInt const* in,Integer* out,std::size_t count,fixed_rounding mode,__int64 lower,__int64 upper)
+        {
+            switch(mode)
+            {
+            case fixed_round_nearest_even:
+                return to_integer<fixed_round_nearest_even>(in,out,count,lower,upper);
+            case fixed_round_floor:
+                return to_integer<fixed_round_floor>(in,out,count,lower,upper);
+            default:
+                return to_integer<fixed_round_truncate>(in,out,count,lower,upper);
+            }
+        }
+
+        // The integer bounds times 2^FracBits, and the bias on top, must fit
+        static FIXED_TARGET("avx2") std::size_t to_int32(StorageInt const* in,int* out,std::size_t count,fixed_rounding mode)
+        {
+            return (FracBits<=32)?to_integer(in,out,count,mode,-0x7fffffff-1,0x7fffffff):0;
+        }
+
+        static FIXED_TARGET("avx2") std::size_t to_int16(StorageInt const* in,short* out,std::size_t count,fixed_rounding mode)
+        {
+            return (FracBits<=48)?to_integer(in,out,count,mode,-0x8000,0x7fff):0;
+        }
+    };
+
+    // Bound on first use like batch_kernels<__int64,FracBits>, to the AVX2
+    // kernels from fixed_batch_avx2 up
+    template<typename StorageInt,unsigned FracBits>
+    struct convert_kernels
+    {
+        static std::size_t (*from_int32)(int const*,StorageInt*,std::size_t);
+        static std::size_t (*from_int16)(short const*,StorageInt*,std::size_t);
+        static std::size_t (*to_int32)(StorageInt const*,int*,std::size_t,fixed_rounding);
+        static std::size_t (*to_int16)(StorageInt const*,short*,std::size_t,fixed_rounding);
+#if !defined(FIXED_NO_FLOATING_POINT)
+        static std::size_t (*from_double)(double const*,StorageInt*,std::size_t,fixed_rounding);
+        static std::size_t (*from_float)(float const*,StorageInt*,std::size_t,fixed_rounding);
+        static std::size_t (*to_double)(StorageInt const*,double*,std::size_t);
+        static std::size_t (*to_float)(StorageInt const*,float*,std::size_t);
+#endif
+
+        template<typename Kernels>
+        static void use()
+        {
+            from_int32=&Kernels::from_int32;
+            from_int16=&Kernels::from_int16;
+            to_int32=&Kernels::to_int32;
+            to_int16=&Kernels::to_int16;
+#if !defined(FIXED_NO_FLOATING_POINT)
+            from_double=&Kernels::from_double;
+            from_float=&Kernels::from_float;
+            to_double=&Kernels::to_double;
+            to_float=&Kernels::to_float;
+#endif
+        }
+
+        static void bind()
+        {
+            if(fixed_batch_level_in_use()>=fixed_batch_avx2)
+            {
+                use<avx2_convert<StorageInt,FracBits> >();
+            }
+            else
+            {
+                use<portable_convert<StorageInt,FracBits> >();
+            }
+        }
+
+        static std::size_t bind_from_int32(int const* in,StorageInt* out,std::size_t count)
+        {
+            bind();
+            return from_int32(in,out,count);
+        }
+        static std::size_t bind_from_int16(short const* in,StorageInt* out,std::size_t count)
+        {
+            bind();
+            return from_int16(in,out,count);
+        }
+        static std::size_t bind_to_int32(StorageInt const* in,int* out,std::size_t count,fixed_rounding mode)
+        {
+            bind();
+            return to_int32(in,out,count,mode);
+        }
+        static std::size_t bind_to_int16(StorageInt const* in,short* out,std::size_t count,fixed_rounding mode)
+        {
+            bind();
+            return to_int16(in,out,count,mode);
+        }
+#if !defined(FIXED_NO_FLOATING_POINT)
+        static std::size_t bind_from_double(double const* in,StorageInt* out,std::size_t count,fixed_rounding mode)
+        {
+            bind();
+            return from_double(in,out,count,mode);
+        }
+        static std::size_t bind_from_float(float const* in,StorageInt* out,std::size_t count,fixed_rounding mode)
+        {
+            bind();
+            return from_float(in,out,count,mode);
+        }
+        static std::size_t bind_to_double(StorageInt const* in,double* out,std::size_t count)
+        {
+            bind();
+            return to_double(in,out,count);
+        }
+        static std::size_t bind_to_float(StorageInt const* in,float* out,std::size_t count)
+        {
+            bind();
+            return to_float(in,out,count);
+        }
+#endif
+    };
+
+    template<typename StorageInt,unsigned FracBits>
+    std::size_t (*convert_kernels<StorageInt,FracBits>::from_int32)(int const*,StorageInt*,std::size_t)=&convert_kernels<StorageInt,FracBits>::bind_from_int32;
+    template<typename StorageInt,unsigned FracBits>
+    std::size_t (*convert_kernels<StorageInt,FracBits>::from_int16)(short const*,StorageInt*,std::size_t)=&convert_kernels<StorageInt,FracBits>::bind_from_int16;
+    template<typename StorageInt,unsigned FracBits>
+    std::size_t (*convert_kernels<StorageInt,FracBits>::to_int32)(StorageInt const*,int*,std::size_t,fixed_rounding)=&convert_kernels<StorageInt,FracBits>::bind_to_int32;
+    template<typename StorageInt,unsigned FracBits>
+    std::size_t (*convert_kernels<StorageInt,FracBits>::to_int16)(StorageInt const*,short*,std::size_t,fixed_rounding)=&convert_kernels<StorageInt,FracBits>::bind_to_int16;
+#if !defined(FIXED_NO_FLOATING_POINT)
+    template<typename StorageInt,unsigned FracBits>
+    std::size_t (*convert_kernels<StorageInt,FracBits>::from_double)(double const*,StorageInt*,std::size_t,fixed_rounding)=&convert_kernels<StorageInt,FracBits>::bind_from_double;
+    template<typename StorageInt,unsigned FracBits>
+    std::size_t (*convert_kernels<StorageInt,FracBits>::from_float)(float const*,StorageInt*,std::size_t,fixed_rounding)=&convert_kernels<StorageInt,FracBits>::bind_from_float;
+    template<typename StorageInt,unsigned FracBits>
+    std::size_t (*convert_kernels<StorageInt,FracBits>::to_double)(StorageInt const*,double*,std::size_t)=&convert_kernels<StorageInt,FracBits>::bind_to_double;
+    template<typename StorageInt,unsigned FracBits>
+    std::size_t (*convert_kernels<StorageInt,FracBits>::to_float)(StorageInt const*,float*,std::size_t)=&convert_kernels<StorageInt,FracBits>::bind_to_float;
+#endif
+#else
+    template<typename StorageInt,unsigned FracBits>
+    struct convert_kernels:
+        portable_convert<StorageInt,FracBits>
+    {};
+#endif
+}
+
+template<typename StorageInt,unsigned FracBits>
+void fixed_convert(int const* in,basic_fixed<StorageInt,FracBits>* out,std::size_t count)
+{
+    StorageInt* const res=raw_values(out);
+    for(std::size_t i=convert_kernels<StorageInt,FracBits>::from_int32(in,res,count);i<count;++i)
+    {
+        res[i]=integer_to_storage<StorageInt,FracBits>(in[i]);
+    }
+}
+
+template<typename StorageInt,unsigned FracBits>
+void fixed_convert(short const* in,basic_fixed<StorageInt,FracBits>* out,std::size_t count)
+{
+    StorageInt* const res=raw_values(out);
+    for(std::size_t i=convert_kernels<StorageInt,FracBits>::from_int16(in,res,count);i<count;++i)
+    {
+        res[i]=integer_to_storage<StorageInt,FracBits>(in[i]);
+    }
+}
+
+template<typename StorageInt,unsigned FracBits>
+void fixed_convert(basic_fixed<StorageInt,FracBits> const* in,int* out,std::size_t count,fixed_rounding mode)
+{
+    StorageInt const* const values=raw_values(in);
+    for(std::size_t i=convert_kernels<StorageInt,FracBits>::to_int32(values,out,count,mode);i<count;++i)
+    {
+        out[i]=int(storage_to_integer<StorageInt,FracBits>(values[i],mode,-0x7fffffff-1,0x7fffffff));
+    }
+}
+
+template<typename StorageInt,unsigned FracBits>
+void fixed_convert(basic_fixed<StorageInt,FracBits> const* in,short* out,std::size_t count,fixed_rounding mode)
+{
+    StorageInt const* const values=raw_values(in);
+    for(std::size_t i=convert_kernels<StorageInt,FracBits>::to_int16(values,out,count,mode);i<count;++i)
+    {
+        out[i]=short(storage_to_integer<StorageInt,FracBits>(values[i],mode,-0x8000,0x7fff));
+    }
+}
+
+#if !defined(FIXED_NO_FLOATING_POINT)
+template<typename StorageInt,unsigned FracBits>
+void fixed_convert(double const* in,basic_fixed<StorageInt,FracBits>* out,std::size_t count,fixed_rounding mode)
+{
+    StorageInt* const res=raw_values(out);
+    for(std::size_t i=convert_kernels<StorageInt,FracBits>::from_double(in,res,count,mode);i<count;++i)
+    {
+        res[i]=double_to_storage<StorageInt,FracBits>(in[i],mode);
+    }
+}
+
+template<typename StorageInt,unsigned FracBits>
+void fixed_convert(float const* in,basic_fixed<StorageInt,FracBits>* out,std::size_t count,fixed_rounding mode)
+{
+    StorageInt* const res=raw_values(out);
+    for(std::size_t i=convert_kernels<StorageInt,FracBits>::from_float(in,res,count,mode);i<count;++i)
+    {
+        res[i]=double_to_storage<StorageInt,FracBits>(in[i],mode);
+    }
+}
+
+template<typename StorageInt,unsigned FracBits>
+void fixed_convert(basic_fixed<StorageInt,FracBits> const* in,double* out,std::size_t count)
+{
+    for(std::size_t i=convert_kernels<StorageInt,FracBits>::to_double(raw_values(in),out,count);i<count;++i)
+    {
+        out[i]=in[i].as_double();
+    }
+}
+
+template<typename StorageInt,unsigned FracBits>
+void fixed_convert(basic_fixed<StorageInt,FracBits> const* in,float* out,std::size_t count)
+{
+    for(std::size_t i=convert_kernels<StorageInt,FracBits>::to_float(raw_values(in),out,count);i<count;++i)
+    {
+        out[i]=in[i].as_float();
+    }
+}
+#endif
+
+namespace
+{
+    // The value of an IEEE 754 pattern with fields of the given widths as a
+    // representation with FracBits, truncated toward zero and saturated;
+    // NaN gives zero, as do subnormals, which are too small for any format
+    template<typename StorageInt,unsigned FracBits>
+    StorageInt ieee_to_storage(unsigned __int64 bits,unsigned mantissa_bits,unsigned exponent_bits)
+    {
+        unsigned __int64 const mantissa_mask=((unsigned __int64)1<<mantissa_bits)-1;
+        unsigned const exponent_mask=(1u<<exponent_bits)-1;
+        unsigned const biased_exponent=unsigned(bits>>mantissa_bits)&exponent_mask;
+        bool const negative=((bits>>(mantissa_bits+exponent_bits))&1)!=0;
+        unsigned __int64 const limit=(unsigned __int64)fixed_storage_traits<StorageInt>::max_value+(negative?1:0);
+        unsigned __int64 magnitude=0;
+        if(biased_exponent==exponent_mask)
+        {
+            magnitude=(bits&mantissa_mask)?0:limit;
+        }
+        else if(biased_exponent)
+        {
+            unsigned __int64 const mantissa=(bits&mantissa_mask)|(mantissa_mask+1);
+            int const shift=int(biased_exponent)-int(exponent_mask>>1)-int(mantissa_bits)+int(FracBits);
+            if(shift<0)
+            {
+                magnitude=(shift>-64)?(mantissa>>-shift):0;
+                magnitude=(magnitude<limit)?magnitude:limit;
+            }
+            else
+            {
+                magnitude=((shift<64) && (mantissa<=(limit>>shift)))?(mantissa<<shift):limit;
+            }
+        }
+        return StorageInt(negative?(0-magnitude):magnitude);
+    }
+
+    // The IEEE 754 pattern nearest magnitude*2^-frac_bits, ties to even as
+    // converting an integer rounds; the exponent always fits
+    inline unsigned __int64 magnitude_to_ieee(unsigned __int64 magnitude,bool negative,unsigned frac_bits,unsigned mantissa_bits,unsigned exponent_bits)
+    {
+        unsigned __int64 const sign=(unsigned __int64)negative<<(mantissa_bits+exponent_bits);
+        if(!magnitude)
+        {
+            return sign;
+        }
+        int top=63-int(count_leading_zeros(magnitude));
+        unsigned __int64 mantissa=0;
+        if(top>int(mantissa_bits))
+        {
+            unsigned const shift=unsigned(top)-mantissa_bits;
+            unsigned __int64 const dropped=magnitude&(((unsigned __int64)1<<shift)-1);
+            unsigned __int64 const half=(unsigned __int64)1<<(shift-1);
+            mantissa=magnitude>>shift;
+            if((dropped>half) || ((dropped==half) && (mantissa&1)))
+            {
+                ++mantissa;
+                if(mantissa>>(mantissa_bits+1))
+                {
+                    mantissa>>=1;
+                    ++top;
+                }
+            }
+        }
+        else
+        {
+            mantissa=magnitude<<(mantissa_bits-unsigned(top));
+        }
+        unsigned __int64 const exponent=(unsigned __int64)(top-int(frac_bits)+int(((1u<<exponent_bits)-1)>>1));
+        return sign|(exponent<<mantissa_bits)|(mantissa&(((unsigned __int64)1<<mantissa_bits)-1));
+    }
+
+    template<typename StorageInt>
+    inline unsigned __int64 magnitude_of(StorageInt value)
+    {
+        return (value<0)?(0-(unsigned __int64)value):(unsigned __int64)value;
+    }
+}
+
+template<typename StorageInt,unsigned FracBits>
+unsigned __int64 basic_fixed<StorageInt,FracBits>::as_double_bits() const
+{
+    return magnitude_to_ieee(magnitude_of(m_nVal),m_nVal<0,FracBits,52,11);
+}
+
+template<typename StorageInt,unsigned FracBits>
+unsigned basic_fixed<StorageInt,FracBits>::as_float_bits() const
+{
+    return unsigned(magnitude_to_ieee(magnitude_of(m_nVal),m_nVal<0,FracBits,23,8));
+}
+
+template<typename StorageInt,unsigned FracBits>
+basic_fixed<StorageInt,FracBits> basic_fixed<StorageInt,FracBits>::from_double_bits(unsigned __int64 bits)
+{
+    return basic_fixed(internal(),ieee_to_storage<StorageInt,FracBits>(bits,52,11));
+}
+
+template<typename StorageInt,unsigned FracBits>
+basic_fixed<StorageInt,FracBits> basic_fixed<StorageInt,FracBits>::from_float_bits(unsigned bits)
+{
+    return basic_fixed(internal(),ieee_to_storage<StorageInt,FracBits>(bits,23,8));
+}
+
+#if defined(FIXED_NO_FLOATING_POINT)
+namespace
+{
+    // A magnitude as decimal digits, each 0 to 9, point of them before the
+    // decimal point. A fraction of frac_bits ends within frac_bits digits,
+    // so all of them fit.
+    struct decimal_digits
+    {
+        char digits[84];
+        int count;
+        int point;
+    };
+
+    inline void to_decimal(unsigned __int64 magnitude,unsigned frac_bits,decimal_digits& res)
+    {
+        char reversed[20];
+        int integer_digits=0;
+        for(unsigned __int64 integer=magnitude>>frac_bits;integer;integer/=10)
+        {
+            reversed[integer_digits++]=char(integer%10);
+        }
+        res.count=0;
+        while(integer_digits)
+        {
+            res.digits[res.count++]=reversed[--integer_digits];
+        }
+        res.point=res.count;
+        if(frac_bits)
+        {
+            unsigned __int64 const mask=~(unsigned __int64)0>>(64-frac_bits);
+            for(unsigned __int64 fraction=magnitude&mask;fraction;)
+            {
+                unsigned __int64 const lower=fraction*10;
+                res.digits[res.count++]=char((multiply_high(fraction,10)<<(64-frac_bits))|(lower>>frac_bits));
+                fraction=lower&mask;
+            }
+        }
+    }
+
+    // Keeps the first keep digits, rounding to nearest with ties to even. A
+    // carry out of the first digit puts a 1 in front.
+    inline void round_decimal(decimal_digits& value,int keep)
+    {
+        if(keep>=value.count)
+        {
+            return;
+        }
+        if(keep<0)
+        {
+            value.count=0;
+            return;
+        }
+        bool up=(value.digits[keep]>5);
+        if(value.digits[keep]==5)
+        {
+            up=(keep>0) && (value.digits[keep-1]&1);
+            for(int i=keep+1;(i<value.count) && !up;++i)
+            {
+                up=(value.digits[i]!=0);
+            }
+        }
+        value.count=keep;
+        if(up)
+        {
+            int i=keep-1;
+            while((i>=0) && (value.digits[i]==9))
+            {
+                value.digits[i--]=0;
+            }
+            if(i>=0)
+            {
+                ++value.digits[i];
+            }
+            else
+            {
+                for(i=keep;i>0;--i)
+                {
+                    value.digits[i]=value.digits[i-1];
+                }
+                value.digits[0]=1;
+                ++value.count;
+                ++value.point;
+            }
+        }
+    }
+
+    // The index of the first non-zero digit, or count if there is none
+    inline int first_significant(decimal_digits const& value)
+    {
+        int i=0;
+        while((i<value.count) && !value.digits[i])
+        {
+            ++i;
+        }
+        return i;
+    }
+
+    // Appends count digits from first on, which are zero outside those held
+    inline void append_digits(std::string& text,decimal_digits const& value,int first,int count)
+    {
+        for(int i=first;i<first+count;++i)
+        {
+            text+=char('0'+(((i>=0) && (i<value.count))?value.digits[i]:0));
+        }
+    }
+
+    // The value as printf() writes it for %f, %e and %g with precision
+    inline void write_fixed(std::string& text,decimal_digits value,int precision,bool point)
+    {
+        round_decimal(value,value.point+precision);
+        if(value.point>0)
+        {
+            append_digits(text,value,0,value.point);
+        }
+        else
+        {
+            text+='0';
+        }
+        if(precision || point)
+        {
+            text+='.';
+            append_digits(text,value,value.point,precision);
+        }
+    }
+
+    // Values lie between 2^-63 and 2^63, so exponents have two digits
+    inline void write_scientific(std::string& text,decimal_digits value,int precision,bool point,bool uppercase)
+    {
+        int first=first_significant(value);
+        int exponent=0;
+        if(first<value.count)
+        {
+            round_decimal(value,first+precision+1);
+            first=first_significant(value);
+            exponent=value.point-1-first;
+        }
+        append_digits(text,value,first,1);
+        if(precision || point)
+        {
+            text+='.';
+            append_digits(text,value,first+1,precision);
+        }
+        text+=uppercase?'E':'e';
+        text+=(exponent<0)?'-':'+';
+        exponent=(exponent<0)?-exponent:exponent;
+        text+=char('0'+exponent/10);
+        text+=char('0'+exponent%10);
+    }
+
+    inline void write_general(std::string& text,decimal_digits const& value,int precision,bool point,bool uppercase)
+    {
+        precision=precision?precision:1;
+        decimal_digits rounded=value;
+        int const first=first_significant(rounded);
+        int exponent=0;
+        if(first<rounded.count)
+        {
+            round_decimal(rounded,first+precision);
+            exponent=rounded.point-1-first_significant(rounded);
+        }
+        std::string::size_type const start=text.size();
+        if((exponent<precision) && (exponent>=-4))
+        {
+            write_fixed(text,value,precision-1-exponent,point);
+        }
+        else
+        {
+            write_scientific(text,value,precision-1,point,uppercase);
+        }
+        std::string::size_type const dot=text.find('.',start);
+        if(!point && (dot!=std::string::npos))
+        {
+            // trailing zeros go, and then the point
+            std::string::size_type const end=(text.find_first_of("eE",dot)==std::string::npos)?text.size():text.find_first_of("eE",dot);
+            std::string::size_type kept=end;
+            while(text[kept-1]=='0')
+            {
+                --kept;
+            }
+            if(kept-1==dot)
+            {
+                --kept;
+            }
+            text.erase(kept,end-kept);
+        }
+    }
+}
+
+template<typename StorageInt,unsigned FracBits>
+std::ostream& operator<<(std::ostream& os,basic_fixed<StorageInt,FracBits> const& value)
+{
+    StorageInt const raw=*raw_values(&value);
+    decimal_digits digits;
+    to_decimal(magnitude_of(raw),FracBits,digits);
+    std::ios_base::fmtflags const flags=os.flags();
+    int const precision=(os.precision()<0)?6:int(os.precision());
+    bool const point=(flags&std::ios_base::showpoint)!=0;
+    bool const uppercase=(flags&std::ios_base::uppercase)!=0;
+    std::string text;
+    if(raw<0)
+    {
+        text+='-';
+    }
+    else if(flags&std::ios_base::showpos)
+    {
+        text+='+';
+    }
+    if((flags&std::ios_base::floatfield)==std::ios_base::fixed)
+    {
+        write_fixed(text,digits,precision,point);
+    }
+    else if((flags&std::ios_base::floatfield)==std::ios_base::scientific)
+    {
+        write_scientific(text,digits,precision,point,uppercase);
+    }
+    else
+    {
+        write_general(text,digits,precision,point,uppercase);
+    }
+    return os<<text;
+}
+#endif
+
+namespace
+{
+    // (upper*2^64+lower)/10 for upper below 10, and its remainder
+    inline unsigned __int64 divide_by_ten(unsigned __int64 upper,unsigned __int64 lower,unsigned* remainder)
+    {
+        unsigned __int64 const high=(upper<<32)|(lower>>32);
+        unsigned __int64 const low=((high%10)<<32)|(lower&0xffffffff);
+        *remainder=unsigned(low%10);
+        return ((high/10)<<32)|(low/10);
+    }
+
+    // The digits of a number in text, indexed without its decimal point
+    struct decimal_text
+    {
+        char const* first;
+        int count;
+        int before_point;
+
+        unsigned digit(int i) const
+        {
+            if((i<0) || (i>=count))
+            {
+                return 0;
+            }
+            return unsigned(first[(i<before_point)?i:(i+1)]-'0');
+        }
+    };
+}
+
+template<typename StorageInt,unsigned FracBits>
+char const* fixed_parse(char const* first,char const* last,basic_fixed<StorageInt,FracBits>* value)
+{
+    char const* p=first;
+    bool const negative=(p!=last) && (*p=='-');
+    if((p!=last) && ((*p=='-') || (*p=='+')))
+    {
+        ++p;
+    }
+    decimal_text text={p,0,-1};
+    for(;p!=last;++p)
+    {
+        if((*p>='0') && (*p<='9'))
+        {
+            ++text.count;
+        }
+        else if((*p=='.') && (text.before_point<0))
+        {
+            text.before_point=text.count;
+        }
+        else
+        {
+            break;
+        }
+    }
+    if(!text.count)
+    {
+        return first;
+    }
+    if(text.before_point<0)
+    {
+        text.before_point=text.count;
+    }
+    // the exponent is capped far beyond where every value saturates or
+    // rounds to zero
+    int exponent=0;
+    if((p!=last) && ((*p=='e') || (*p=='E')))
+    {
+        char const* q=p+1;
+        bool const negative_exponent=(q!=last) && (*q=='-');
+        if((q!=last) && ((*q=='-') || (*q=='+')))
+        {
+            ++q;
+        }
+        if((q!=last) && (*q>='0') && (*q<='9'))
+        {
+            for(;(q!=last) && (*q>='0') && (*q<='9');++q)
+            {
+                exponent=(exponent<100000)?(exponent*10+(*q-'0')):exponent;
+            }
+            exponent=negative_exponent?-exponent:exponent;
+            p=q;
+        }
+    }
+    int const point=text.before_point+exponent;
+    unsigned __int64 const limit=(unsigned __int64)fixed_storage_traits<StorageInt>::max_value+(negative?1:0);
+    unsigned __int64 const max_integer=limit>>FracBits;
+
+    unsigned __int64 integer=0;
+    bool saturate=false;
+    for(int i=0;(i<point) && ((i<text.count) || integer);++i)
+    {
+        unsigned const digit=text.digit(i);
+        if((integer>max_integer/10) || (integer*10+digit>max_integer))
+        {
+            saturate=true;
+            break;
+        }
+        integer=integer*10+digit;
+    }
+
+    // Halfway points between values are multiples of 10^-(FracBits+1), so
+    // the fraction digits up to there settle the rounding, and later ones
+    // only break ties. Working back from the last of them, each step takes
+    // (digit*2^FracBits+carried)/10, truncating as the whole sum would.
+    bool inexact=false;
+    for(int i=(point+int(FracBits)+1>0)?(point+int(FracBits)+1):0;(i<text.count) && !inexact;++i)
+    {
+        inexact=(text.digit(i)!=0);
+    }
+    unsigned __int64 fraction=0;
+    unsigned remainder=0;
+    for(int place=int(FracBits)+1;place>0;--place)
+    {
+        inexact=inexact || remainder;
+        unsigned __int64 const digit=text.digit(point-1+place);
+        unsigned __int64 const lower=(digit<<FracBits)+fraction;
+        unsigned __int64 const upper=(FracBits?(digit>>(64-FracBits)):0)+(lower<fraction);
+        fraction=divide_by_ten(upper,lower,&remainder);
+    }
+    if((remainder>5) || ((remainder==5) && (inexact || (fraction&1))))
+    {
+        ++fraction;
+    }
+
+    unsigned __int64 magnitude=limit;
+    if(!saturate)
+    {
+        magnitude=(integer<<FracBits)+fraction;
+        magnitude=(magnitude>limit)?limit:magnitude;
+    }
+    *value=basic_fixed<StorageInt,FracBits>(typename basic_fixed<StorageInt,FracBits>::internal(),StorageInt(negative?(0-magnitude):magnitude));
+    return p;
+}
+
+template<typename StorageInt,unsigned FracBits>
+std::istream& operator>>(std::istream& is,basic_fixed<StorageInt,FracBits>& value)
+{
+    std::istream::sentry const ok(is);
+    if(ok)
+    {
+        // the longest run of characters that can go on to form a number
+        std::string text;
+        bool point=false;
+        bool exponent=false;
+        std::streambuf& buffer=*is.rdbuf();
+        for(int c=buffer.sgetc();;c=buffer.snextc())
+        {
+            if(c==std::char_traits<char>::eof())
+            {
+                is.setstate(std::ios_base::eofbit);
+                break;
+            }
+            char const next=char(c);
+            char const previous=text.empty()?'\0':text[text.size()-1];
+            bool const digit=(next>='0') && (next<='9');
+            bool const sign=((next=='+') || (next=='-')) && (text.empty() || (previous=='e') || (previous=='E'));
+            bool const starts_exponent=((next=='e') || (next=='E')) && !exponent && (text.find_first_of("0123456789")!=std::string::npos);
+            if(!digit && !sign && !starts_exponent && ((next!='.') || point || exponent))
+            {
+                break;
+            }
+            point=point || (next=='.');
+            exponent=exponent || starts_exponent;
+            text+=next;
+        }
+        char const* const first=text.c_str();
+        char const* const last=first+text.size();
+        if(text.empty() || (fixed_parse(first,last,&value)!=last))
+        {
+            is.setstate(std::ios_base::failbit);
+        }
+    }
+    return is;
+}
+
+#if !defined(FIXED_HEADER_ONLY)
+template class basic_fixed<__int64,fixed_resolution_shift>;
+template class basic_fixed<int,16>;
+template void fixed_mul(fixed const*,fixed const*,fixed*,std::size_t);
+template void fixed_add(fixed const*,fixed const*,fixed*,std::size_t);
+template void fixed_sub(fixed const*,fixed const*,fixed*,std::size_t);
+template void fixed_scale(fixed const*,int,fixed*,std::size_t);
+template void fixed_abs(fixed const*,fixed*,std::size_t);
+template void fixed_minimum(fixed const*,fixed const*,fixed*,std::size_t);
+template void fixed_maximum(fixed const*,fixed const*,fixed*,std::size_t);
+template void fixed_clamp(fixed const*,fixed const&,fixed const&,fixed*,std::size_t);
+template void fixed_convert(int const*,fixed*,std::size_t);
+template void fixed_convert(short const*,fixed*,std::size_t);
+template void fixed_convert(fixed const*,int*,std::size_t,fixed_rounding);
+template void fixed_convert(fixed const*,short*,std::size_t,fixed_rounding);
+template char const* fixed_parse(char const*,char const*,fixed*);
+template std::istream& operator>>(std::istream&,fixed&);
+#if defined(FIXED_NO_FLOATING_POINT)
+template std::ostream& operator<<(std::ostream&,fixed const&);
+#endif
+#if !defined(FIXED_NO_FLOATING_POINT)
+template void fixed_convert(double const*,fixed*,std::size_t,fixed_rounding);
+template void fixed_convert(float const*,fixed*,std::size_t,fixed_rounding);
+template void fixed_convert(fixed const*,double*,std::size_t);
+template void fixed_convert(fixed const*,float*,std::size_t);
+#endif
+template void fixed_mul(fixed32 const*,fixed32 const*,fixed32*,std::size_t);
+template void fixed_add(fixed32 const*,fixed32 const*,fixed32*,std::size_t);
+template void fixed_sub(fixed32 const*,fixed32 const*,fixed32*,std::size_t);
+template void fixed_scale(fixed32 const*,int,fixed32*,std::size_t);
+template void fixed_abs(fixed32 const*,fixed32*,std::size_t);
+template void fixed_minimum(fixed32 const*,fixed32 const*,fixed32*,std::size_t);
+template void fixed_maximum(fixed32 const*,fixed32 const*,fixed32*,std::size_t);
+template void fixed_clamp(fixed32 const*,fixed32 const&,fixed32 const&,fixed32*,std::size_t);
+template void fixed_convert(int const*,fixed32*,std::size_t);
+template void fixed_convert(short const*,fixed32*,std::size_t);
+template void fixed_convert(fixed32 const*,int*,std::size_t,fixed_rounding);
+template void fixed_convert(fixed32 const*,short*,std::size_t,fixed_rounding);
+template char const* fixed_parse(char const*,char const*,fixed32*);
+template std::istream& operator>>(std::istream&,fixed32&);
+#if defined(FIXED_NO_FLOATING_POINT)
+template std::ostream& operator<<(std::ostream&,fixed32 const&);
+#endif
+#if !defined(FIXED_NO_FLOATING_POINT)
+template void fixed_convert(double const*,fixed32*,std::size_t,fixed_rounding);
+template void fixed_convert(float const*,fixed32*,std::size_t,fixed_rounding);
+template void fixed_convert(fixed32 const*,double*,std::size_t);
+template void fixed_convert(fixed32 const*,float*,std::size_t);
+#endif
+#endif
+
+#endif
+
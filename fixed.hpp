@@ -1,1614 +1,3434 @@
-#ifndef FIXED_HPP
-#define FIXED_HPP
-// Distributed under the Boost Software License, Version 1.0. (See
-// accompanying file LICENSE_1_0.txt or copy at
-// http://www.boost.org/LICENSE_1_0.txt)
-// (C) Copyright 2007 Anthony Williams
-
-#include <ostream>
-#include <complex>
-
-unsigned const fixed_resolution_shift=28;
-__int64 const fixed_resolution=1I64<<fixed_resolution_shift;
-
-class fixed
-{
-private:
-    __int64 m_nVal;
-
-public:
-
-    struct internal
-    {};
-
-    fixed():
-        m_nVal(0)
-    {}
-    
-    fixed(internal, __int64 nVal):
-        m_nVal(nVal)
-    {}
-    fixed(__int64 nVal):
-        m_nVal(nVal<<fixed_resolution_shift)
-    {}
-    
-    fixed(long nVal):
-        m_nVal(__int64(nVal)<<fixed_resolution_shift)
-    {}
-    
-    fixed(int nVal):
-        m_nVal(__int64(nVal)<<fixed_resolution_shift)
-    {}
-    
-    fixed(short nVal):
-        m_nVal(__int64(nVal)<<fixed_resolution_shift)
-    {}
-    
-    fixed(unsigned __int64 nVal):
-        m_nVal(nVal<<fixed_resolution_shift)
-    {}
-    
-    fixed(unsigned long nVal):
-        m_nVal(__int64(nVal)<<fixed_resolution_shift)
-    {}
-    fixed(unsigned int nVal):
-        m_nVal(__int64(nVal)<<fixed_resolution_shift)
-    {}
-    fixed(unsigned short nVal):
-        m_nVal(__int64(nVal)<<fixed_resolution_shift)
-    {}
-    fixed(double nVal):
-        m_nVal(static_cast<__int64>(nVal*static_cast<double>(fixed_resolution)))
-    {}
-    fixed(float nVal):
-        m_nVal(static_cast<__int64>(nVal*static_cast<float>(fixed_resolution)))
-    {}
-
-    template<typename T>
-    fixed& operator=(T other)
-    {
-        m_nVal=fixed(other).m_nVal;
-        return *this;
-    }
-    fixed& operator=(fixed const& other)
-    {
-        m_nVal=other.m_nVal;
-        return *this;
-    }
-    friend bool operator==(fixed const& lhs,fixed const& rhs)
-    {
-        return lhs.m_nVal==rhs.m_nVal;
-    }
-    friend bool operator!=(fixed const& lhs,fixed const& rhs)
-    {
-        return lhs.m_nVal!=rhs.m_nVal;
-    }
-    friend bool operator<(fixed const& lhs,fixed const& rhs)
-    {
-        return lhs.m_nVal<rhs.m_nVal;
-    }
-    friend bool operator>(fixed const& lhs,fixed const& rhs)
-    {
-        return lhs.m_nVal>rhs.m_nVal;
-    }
-    friend bool operator<=(fixed const& lhs,fixed const& rhs)
-    {
-        return lhs.m_nVal<=rhs.m_nVal;
-    }
-    friend bool operator>=(fixed const& lhs,fixed const& rhs)
-    {
-        return lhs.m_nVal>=rhs.m_nVal;
-    }
-    operator bool() const
-    {
-        return m_nVal?true:false;
-    }
-    inline operator double() const
-    {
-        return as_double();
-    }
-    float as_float() const
-    {
-        return m_nVal/(float)fixed_resolution;
-    }
-
-    double as_double() const
-    {
-        return m_nVal/(double)fixed_resolution;
-    }
-
-    long as_long() const
-    {
-        return (long)(m_nVal/fixed_resolution);
-    }
-    __int64 as_int64() const
-    {
-        return m_nVal/fixed_resolution;
-    }
-
-    int as_int() const
-    {
-        return (int)(m_nVal/fixed_resolution);
-    }
-
-    unsigned long as_unsigned_long() const
-    {
-        return (unsigned long)(m_nVal/fixed_resolution);
-    }
-    unsigned __int64 as_unsigned_int64() const
-    {
-        return (unsigned __int64)m_nVal/fixed_resolution;
-    }
-
-    unsigned int as_unsigned_int() const
-    {
-        return (unsigned int)(m_nVal/fixed_resolution);
-    }
-
-    short as_short() const
-    {
-        return (short)(m_nVal/fixed_resolution);
-    }
-
-    unsigned short as_unsigned_short() const
-    {
-        return (unsigned short)(m_nVal/fixed_resolution);
-    }
-
-    fixed operator++()
-    {
-        m_nVal += fixed_resolution;
-        return *this;
-    }
-
-    fixed operator--()
-    {
-        m_nVal -= fixed_resolution;
-        return *this;
-    }
-
-    fixed floor() const;
-    fixed ceil() const;
-    fixed sqrt() const;
-    fixed exp() const;
-    fixed log() const;
-    fixed& operator%=(fixed const& other);
-    fixed& operator*=(fixed const& val);
-    fixed& operator/=(fixed const& val);
-    fixed& operator-=(fixed const& val)
-    {
-        m_nVal -= val.m_nVal;
-        return *this;
-    }
-
-    fixed& operator+=(fixed const& val)
-    {
-        m_nVal += val.m_nVal;
-        return *this;
-    }
-    fixed& operator*=(double val)
-    {
-        return (*this)*=fixed(val);
-    }
-    fixed& operator*=(float val)
-    {
-        return (*this)*=fixed(val);
-    }
-    fixed& operator*=(__int64 val)
-    {
-        m_nVal*=val;
-        return *this;
-    }
-    fixed& operator*=(long val)
-    {
-        m_nVal*=val;
-        return *this;
-    }
-    fixed& operator*=(int val)
-    {
-        m_nVal*=val;
-        return *this;
-    }
-    fixed& operator*=(short val)
-    {
-        m_nVal*=val;
-        return *this;
-    }
-    fixed& operator*=(char val)
-    {
-        m_nVal*=val;
-        return *this;
-    }
-    fixed& operator*=(unsigned __int64 val)
-    {
-        m_nVal*=val;
-        return *this;
-    }
-    fixed& operator*=(unsigned long val)
-    {
-        m_nVal*=val;
-        return *this;
-    }
-    fixed& operator*=(unsigned int val)
-    {
-        m_nVal*=val;
-        return *this;
-    }
-    fixed& operator*=(unsigned short val)
-    {
-        m_nVal*=val;
-        return *this;
-    }
-    fixed& operator*=(unsigned char val)
-    {
-        m_nVal*=val;
-        return *this;
-    }
-    fixed& operator/=(double val)
-    {
-        return (*this)/=fixed(val);
-    }
-    fixed& operator/=(float val)
-    {
-        return (*this)/=fixed(val);
-    }
-    fixed& operator/=(__int64 val)
-    {
-        m_nVal/=val;
-        return *this;
-    }
-    fixed& operator/=(long val)
-    {
-        m_nVal/=val;
-        return *this;
-    }
-    fixed& operator/=(int val)
-    {
-        m_nVal/=val;
-        return *this;
-    }
-    fixed& operator/=(short val)
-    {
-        m_nVal/=val;
-        return *this;
-    }
-    fixed& operator/=(char val)
-    {
-        m_nVal/=val;
-        return *this;
-    }
-    fixed& operator/=(unsigned __int64 val)
-    {
-        m_nVal/=val;
-        return *this;
-    }
-    fixed& operator/=(unsigned long val)
-    {
-        m_nVal/=val;
-        return *this;
-    }
-    fixed& operator/=(unsigned int val)
-    {
-        m_nVal/=val;
-        return *this;
-    }
-    fixed& operator/=(unsigned short val)
-    {
-        m_nVal/=val;
-        return *this;
-    }
-    fixed& operator/=(unsigned char val)
-    {
-        m_nVal/=val;
-        return *this;
-    }
-    
-
-    bool operator!() const
-    {
-        return m_nVal==0;
-    }
-    
-    fixed modf(fixed* integral_part) const;
-    fixed atan() const;
-
-    static void sin_cos(fixed const& theta,fixed* s,fixed*c);
-    static void to_polar(fixed const& x,fixed const& y,fixed* r,fixed*theta);
-
-    fixed sin() const;
-    fixed cos() const;
-    fixed tan() const;
-    fixed operator-() const;
-    fixed abs() const;
-};
-
-inline std::ostream& operator<<(std::ostream& os,fixed const& value)
-{
-    return os<<value.as_double();
-}
-
-inline fixed operator-(double a, fixed const& b)
-{
-    fixed temp(a);
-    return temp-=b;
-}
-
-
-inline fixed operator-(float a, fixed const& b)
-{
-    fixed temp(a);
-    return temp-=b;
-}
-
-inline fixed operator-(unsigned long a, fixed const& b)
-{
-    fixed temp(a);
-    return temp-=b;
-}
-
-inline fixed operator-(long a, fixed const& b)
-{
-    fixed temp(a);
-    return temp-=b;
-}
-
-inline fixed operator-(unsigned a, fixed const& b)
-{
-    fixed temp(a);
-    return temp-=b;
-}
-
-inline fixed operator-(int a, fixed const& b)
-{
-    fixed temp(a);
-    return temp-=b;
-}
-
-inline fixed operator-(unsigned short a, fixed const& b)
-{
-    fixed temp(a);
-    return temp-=b;
-}
-
-inline fixed operator-(short a, fixed const& b)
-{
-    fixed temp(a);
-    return temp-=b;
-}
-
-inline fixed operator-(unsigned char a, fixed const& b)
-{
-    fixed temp(a);
-    return temp-=b;
-}
-
-inline fixed operator-(char a, fixed const& b)
-{
-    fixed temp(a);
-    return temp-=b;
-}
-
-inline fixed operator-(fixed const& a,double b)
-{
-    fixed temp(a);
-    return temp-=b;
-}
-
-
-inline fixed operator-(fixed const& a,float b)
-{
-    fixed temp(a);
-    return temp-=b;
-}
-
-inline fixed operator-(fixed const& a,unsigned long b)
-{
-    fixed temp(a);
-    return temp-=b;
-}
-
-inline fixed operator-(fixed const& a,long b)
-{
-    fixed temp(a);
-    return temp-=b;
-}
-
-inline fixed operator-(fixed const& a,unsigned b)
-{
-    fixed temp(a);
-    return temp-=b;
-}
-
-inline fixed operator-(fixed const& a,int b)
-{
-    fixed temp(a);
-    return temp-=b;
-}
-
-inline fixed operator-(fixed const& a,unsigned short b)
-{
-    fixed temp(a);
-    return temp-=b;
-}
-
-inline fixed operator-(fixed const& a,short b)
-{
-    fixed temp(a);
-    return temp-=b;
-}
-
-inline fixed operator-(fixed const& a,unsigned char b)
-{
-    fixed temp(a);
-    return temp-=b;
-}
-
-inline fixed operator-(fixed const& a,char b)
-{
-    fixed temp(a);
-    return temp-=b;
-}
-
-inline fixed operator-(fixed const& a,fixed const& b)
-{
-    fixed temp(a);
-    return temp-=b;
-}
-
-inline fixed operator%(double a, fixed const& b)
-{
-    fixed temp(a);
-    return temp%=b;
-}
-
-
-inline fixed operator%(float a, fixed const& b)
-{
-    fixed temp(a);
-    return temp%=b;
-}
-
-inline fixed operator%(unsigned long a, fixed const& b)
-{
-    fixed temp(a);
-    return temp%=b;
-}
-
-inline fixed operator%(long a, fixed const& b)
-{
-    fixed temp(a);
-    return temp%=b;
-}
-
-inline fixed operator%(unsigned a, fixed const& b)
-{
-    fixed temp(a);
-    return temp%=b;
-}
-
-inline fixed operator%(int a, fixed const& b)
-{
-    fixed temp(a);
-    return temp%=b;
-}
-
-inline fixed operator%(unsigned short a, fixed const& b)
-{
-    fixed temp(a);
-    return temp%=b;
-}
-
-inline fixed operator%(short a, fixed const& b)
-{
-    fixed temp(a);
-    return temp%=b;
-}
-
-inline fixed operator%(unsigned char a, fixed const& b)
-{
-    fixed temp(a);
-    return temp%=b;
-}
-
-inline fixed operator%(char a, fixed const& b)
-{
-    fixed temp(a);
-    return temp%=b;
-}
-
-inline fixed operator%(fixed const& a,double b)
-{
-    fixed temp(a);
-    return temp%=b;
-}
-
-
-inline fixed operator%(fixed const& a,float b)
-{
-    fixed temp(a);
-    return temp%=b;
-}
-
-inline fixed operator%(fixed const& a,unsigned long b)
-{
-    fixed temp(a);
-    return temp%=b;
-}
-
-inline fixed operator%(fixed const& a,long b)
-{
-    fixed temp(a);
-    return temp%=b;
-}
-
-inline fixed operator%(fixed const& a,unsigned b)
-{
-    fixed temp(a);
-    return temp%=b;
-}
-
-inline fixed operator%(fixed const& a,int b)
-{
-    fixed temp(a);
-    return temp%=b;
-}
-
-inline fixed operator%(fixed const& a,unsigned short b)
-{
-    fixed temp(a);
-    return temp%=b;
-}
-
-inline fixed operator%(fixed const& a,short b)
-{
-    fixed temp(a);
-    return temp%=b;
-}
-
-inline fixed operator%(fixed const& a,unsigned char b)
-{
-    fixed temp(a);
-    return temp%=b;
-}
-
-inline fixed operator%(fixed const& a,char b)
-{
-    fixed temp(a);
-    return temp%=b;
-}
-
-inline fixed operator%(fixed const& a,fixed const& b)
-{
-    fixed temp(a);
-    return temp%=b;
-}
-
-inline fixed operator+(double a, fixed const& b)
-{
-    fixed temp(a);
-    return temp+=b;
-}
-
-
-inline fixed operator+(float a, fixed const& b)
-{
-    fixed temp(a);
-    return temp+=b;
-}
-
-inline fixed operator+(unsigned long a, fixed const& b)
-{
-    fixed temp(a);
-    return temp+=b;
-}
-
-inline fixed operator+(long a, fixed const& b)
-{
-    fixed temp(a);
-    return temp+=b;
-}
-
-inline fixed operator+(unsigned a, fixed const& b)
-{
-    fixed temp(a);
-    return temp+=b;
-}
-
-inline fixed operator+(int a, fixed const& b)
-{
-    fixed temp(a);
-    return temp+=b;
-}
-
-inline fixed operator+(unsigned short a, fixed const& b)
-{
-    fixed temp(a);
-    return temp+=b;
-}
-
-inline fixed operator+(short a, fixed const& b)
-{
-    fixed temp(a);
-    return temp+=b;
-}
-
-inline fixed operator+(unsigned char a, fixed const& b)
-{
-    fixed temp(a);
-    return temp+=b;
-}
-
-inline fixed operator+(char a, fixed const& b)
-{
-    fixed temp(a);
-    return temp+=b;
-}
-
-inline fixed operator+(fixed const& a,double b)
-{
-    fixed temp(a);
-    return temp+=b;
-}
-
-
-inline fixed operator+(fixed const& a,float b)
-{
-    fixed temp(a);
-    return temp+=b;
-}
-
-inline fixed operator+(fixed const& a,unsigned long b)
-{
-    fixed temp(a);
-    return temp+=b;
-}
-
-inline fixed operator+(fixed const& a,long b)
-{
-    fixed temp(a);
-    return temp+=b;
-}
-
-inline fixed operator+(fixed const& a,unsigned b)
-{
-    fixed temp(a);
-    return temp+=b;
-}
-
-inline fixed operator+(fixed const& a,int b)
-{
-    fixed temp(a);
-    return temp+=b;
-}
-
-inline fixed operator+(fixed const& a,unsigned short b)
-{
-    fixed temp(a);
-    return temp+=b;
-}
-
-inline fixed operator+(fixed const& a,short b)
-{
-    fixed temp(a);
-    return temp+=b;
-}
-
-inline fixed operator+(fixed const& a,unsigned char b)
-{
-    fixed temp(a);
-    return temp+=b;
-}
-
-inline fixed operator+(fixed const& a,char b)
-{
-    fixed temp(a);
-    return temp+=b;
-}
-
-inline fixed operator+(fixed const& a,fixed const& b)
-{
-    fixed temp(a);
-    return temp+=b;
-}
-
-inline fixed operator*(double a, fixed const& b)
-{
-    fixed temp(b);
-    return temp*=a;
-}
-
-
-inline fixed operator*(float a, fixed const& b)
-{
-    fixed temp(b);
-    return temp*=a;
-}
-
-inline fixed operator*(unsigned long a, fixed const& b)
-{
-    fixed temp(b);
-    return temp*=a;
-}
-
-inline fixed operator*(long a, fixed const& b)
-{
-    fixed temp(b);
-    return temp*=a;
-}
-
-inline fixed operator*(unsigned a, fixed const& b)
-{
-    fixed temp(b);
-    return temp*=a;
-}
-
-inline fixed operator*(int a, fixed const& b)
-{
-    fixed temp(b);
-    return temp*=a;
-}
-
-inline fixed operator*(unsigned short a, fixed const& b)
-{
-    fixed temp(b);
-    return temp*=a;
-}
-
-inline fixed operator*(short a, fixed const& b)
-{
-    fixed temp(b);
-    return temp*=a;
-}
-
-inline fixed operator*(unsigned char a, fixed const& b)
-{
-    fixed temp(b);
-    return temp*=a;
-}
-
-inline fixed operator*(char a, fixed const& b)
-{
-    fixed temp(b);
-    return temp*=a;
-}
-
-inline fixed operator*(fixed const& a,double b)
-{
-    fixed temp(a);
-    return temp*=b;
-}
-
-
-inline fixed operator*(fixed const& a,float b)
-{
-    fixed temp(a);
-    return temp*=b;
-}
-
-inline fixed operator*(fixed const& a,unsigned long b)
-{
-    fixed temp(a);
-    return temp*=b;
-}
-
-inline fixed operator*(fixed const& a,long b)
-{
-    fixed temp(a);
-    return temp*=b;
-}
-
-inline fixed operator*(fixed const& a,unsigned b)
-{
-    fixed temp(a);
-    return temp*=b;
-}
-
-inline fixed operator*(fixed const& a,int b)
-{
-    fixed temp(a);
-    return temp*=b;
-}
-
-inline fixed operator*(fixed const& a,unsigned short b)
-{
-    fixed temp(a);
-    return temp*=b;
-}
-
-inline fixed operator*(fixed const& a,short b)
-{
-    fixed temp(a);
-    return temp*=b;
-}
-
-inline fixed operator*(fixed const& a,unsigned char b)
-{
-    fixed temp(a);
-    return temp*=b;
-}
-
-inline fixed operator*(fixed const& a,char b)
-{
-    fixed temp(a);
-    return temp*=b;
-}
-
-inline fixed operator*(fixed const& a,fixed const& b)
-{
-    fixed temp(a);
-    return temp*=b;
-}
-
-inline fixed operator/(double a, fixed const& b)
-{
-    fixed temp(a);
-    return temp/=b;
-}
-
-
-inline fixed operator/(float a, fixed const& b)
-{
-    fixed temp(a);
-    return temp/=b;
-}
-
-inline fixed operator/(unsigned long a, fixed const& b)
-{
-    fixed temp(a);
-    return temp/=b;
-}
-
-inline fixed operator/(long a, fixed const& b)
-{
-    fixed temp(a);
-    return temp/=b;
-}
-
-inline fixed operator/(unsigned a, fixed const& b)
-{
-    fixed temp(a);
-    return temp/=b;
-}
-
-inline fixed operator/(int a, fixed const& b)
-{
-    fixed temp(a);
-    return temp/=b;
-}
-
-inline fixed operator/(unsigned short a, fixed const& b)
-{
-    fixed temp(a);
-    return temp/=b;
-}
-
-inline fixed operator/(short a, fixed const& b)
-{
-    fixed temp(a);
-    return temp/=b;
-}
-
-inline fixed operator/(unsigned char a, fixed const& b)
-{
-    fixed temp(a);
-    return temp/=b;
-}
-
-inline fixed operator/(char a, fixed const& b)
-{
-    fixed temp(a);
-    return temp/=b;
-}
-
-inline fixed operator/(fixed const& a,double b)
-{
-    fixed temp(a);
-    return temp/=b;
-}
-
-
-inline fixed operator/(fixed const& a,float b)
-{
-    fixed temp(a);
-    return temp/=b;
-}
-
-inline fixed operator/(fixed const& a,unsigned long b)
-{
-    fixed temp(a);
-    return temp/=b;
-}
-
-inline fixed operator/(fixed const& a,long b)
-{
-    fixed temp(a);
-    return temp/=b;
-}
-
-inline fixed operator/(fixed const& a,unsigned b)
-{
-    fixed temp(a);
-    return temp/=b;
-}
-
-inline fixed operator/(fixed const& a,int b)
-{
-    fixed temp(a);
-    return temp/=b;
-}
-
-inline fixed operator/(fixed const& a,unsigned short b)
-{
-    fixed temp(a);
-    return temp/=b;
-}
-
-inline fixed operator/(fixed const& a,short b)
-{
-    fixed temp(a);
-    return temp/=b;
-}
-
-inline fixed operator/(fixed const& a,unsigned char b)
-{
-    fixed temp(a);
-    return temp/=b;
-}
-
-inline fixed operator/(fixed const& a,char b)
-{
-    fixed temp(a);
-    return temp/=b;
-}
-
-inline fixed operator/(fixed const& a,fixed const& b)
-{
-    fixed temp(a);
-    return temp/=b;
-}
-
-inline bool operator==(double a, fixed const& b)
-{
-    return fixed(a)==b;
-}
-inline bool operator==(float a, fixed const& b)
-{
-    return fixed(a)==b;
-}
-
-inline bool operator==(unsigned long a, fixed const& b)
-{
-    return fixed(a)==b;
-}
-inline bool operator==(long a, fixed const& b)
-{
-    return fixed(a)==b;
-}
-inline bool operator==(unsigned a, fixed const& b)
-{
-    return fixed(a)==b;
-}
-inline bool operator==(int a, fixed const& b)
-{
-    return fixed(a)==b;
-}
-inline bool operator==(unsigned short a, fixed const& b)
-{
-    return fixed(a)==b;
-}
-inline bool operator==(short a, fixed const& b)
-{
-    return fixed(a)==b;
-}
-inline bool operator==(unsigned char a, fixed const& b)
-{
-    return fixed(a)==b;
-}
-inline bool operator==(char a, fixed const& b)
-{
-    return fixed(a)==b;
-}
-
-inline bool operator==(fixed const& a,double b)
-{
-    return a==fixed(b);
-}
-inline bool operator==(fixed const& a,float b)
-{
-    return a==fixed(b);
-}
-inline bool operator==(fixed const& a,unsigned long b)
-{
-    return a==fixed(b);
-}
-inline bool operator==(fixed const& a,long b)
-{
-    return a==fixed(b);
-}
-inline bool operator==(fixed const& a,unsigned b)
-{
-    return a==fixed(b);
-}
-inline bool operator==(fixed const& a,int b)
-{
-    return a==fixed(b);
-}
-inline bool operator==(fixed const& a,unsigned short b)
-{
-    return a==fixed(b);
-}
-inline bool operator==(fixed const& a,short b)
-{
-    return a==fixed(b);
-}
-inline bool operator==(fixed const& a,unsigned char b)
-{
-    return a==fixed(b);
-}
-inline bool operator==(fixed const& a,char b)
-{
-    return a==fixed(b);
-}
-
-inline bool operator!=(double a, fixed const& b)
-{
-    return fixed(a)!=b;
-}
-inline bool operator!=(float a, fixed const& b)
-{
-    return fixed(a)!=b;
-}
-
-inline bool operator!=(unsigned long a, fixed const& b)
-{
-    return fixed(a)!=b;
-}
-inline bool operator!=(long a, fixed const& b)
-{
-    return fixed(a)!=b;
-}
-inline bool operator!=(unsigned a, fixed const& b)
-{
-    return fixed(a)!=b;
-}
-inline bool operator!=(int a, fixed const& b)
-{
-    return fixed(a)!=b;
-}
-inline bool operator!=(unsigned short a, fixed const& b)
-{
-    return fixed(a)!=b;
-}
-inline bool operator!=(short a, fixed const& b)
-{
-    return fixed(a)!=b;
-}
-inline bool operator!=(unsigned char a, fixed const& b)
-{
-    return fixed(a)!=b;
-}
-inline bool operator!=(char a, fixed const& b)
-{
-    return fixed(a)!=b;
-}
-
-inline bool operator!=(fixed const& a,double b)
-{
-    return a!=fixed(b);
-}
-inline bool operator!=(fixed const& a,float b)
-{
-    return a!=fixed(b);
-}
-inline bool operator!=(fixed const& a,unsigned long b)
-{
-    return a!=fixed(b);
-}
-inline bool operator!=(fixed const& a,long b)
-{
-    return a!=fixed(b);
-}
-inline bool operator!=(fixed const& a,unsigned b)
-{
-    return a!=fixed(b);
-}
-inline bool operator!=(fixed const& a,int b)
-{
-    return a!=fixed(b);
-}
-inline bool operator!=(fixed const& a,unsigned short b)
-{
-    return a!=fixed(b);
-}
-inline bool operator!=(fixed const& a,short b)
-{
-    return a!=fixed(b);
-}
-inline bool operator!=(fixed const& a,unsigned char b)
-{
-    return a!=fixed(b);
-}
-inline bool operator!=(fixed const& a,char b)
-{
-    return a!=fixed(b);
-}
-
-inline bool operator<(double a, fixed const& b)
-{
-    return fixed(a)<b;
-}
-inline bool operator<(float a, fixed const& b)
-{
-    return fixed(a)<b;
-}
-
-inline bool operator<(unsigned long a, fixed const& b)
-{
-    return fixed(a)<b;
-}
-inline bool operator<(long a, fixed const& b)
-{
-    return fixed(a)<b;
-}
-inline bool operator<(unsigned a, fixed const& b)
-{
-    return fixed(a)<b;
-}
-inline bool operator<(int a, fixed const& b)
-{
-    return fixed(a)<b;
-}
-inline bool operator<(unsigned short a, fixed const& b)
-{
-    return fixed(a)<b;
-}
-inline bool operator<(short a, fixed const& b)
-{
-    return fixed(a)<b;
-}
-inline bool operator<(unsigned char a, fixed const& b)
-{
-    return fixed(a)<b;
-}
-inline bool operator<(char a, fixed const& b)
-{
-    return fixed(a)<b;
-}
-
-inline bool operator<(fixed const& a,double b)
-{
-    return a<fixed(b);
-}
-inline bool operator<(fixed const& a,float b)
-{
-    return a<fixed(b);
-}
-inline bool operator<(fixed const& a,unsigned long b)
-{
-    return a<fixed(b);
-}
-inline bool operator<(fixed const& a,long b)
-{
-    return a<fixed(b);
-}
-inline bool operator<(fixed const& a,unsigned b)
-{
-    return a<fixed(b);
-}
-inline bool operator<(fixed const& a,int b)
-{
-    return a<fixed(b);
-}
-inline bool operator<(fixed const& a,unsigned short b)
-{
-    return a<fixed(b);
-}
-inline bool operator<(fixed const& a,short b)
-{
-    return a<fixed(b);
-}
-inline bool operator<(fixed const& a,unsigned char b)
-{
-    return a<fixed(b);
-}
-inline bool operator<(fixed const& a,char b)
-{
-    return a<fixed(b);
-}
-
-inline bool operator>(double a, fixed const& b)
-{
-    return fixed(a)>b;
-}
-inline bool operator>(float a, fixed const& b)
-{
-    return fixed(a)>b;
-}
-
-inline bool operator>(unsigned long a, fixed const& b)
-{
-    return fixed(a)>b;
-}
-inline bool operator>(long a, fixed const& b)
-{
-    return fixed(a)>b;
-}
-inline bool operator>(unsigned a, fixed const& b)
-{
-    return fixed(a)>b;
-}
-inline bool operator>(int a, fixed const& b)
-{
-    return fixed(a)>b;
-}
-inline bool operator>(unsigned short a, fixed const& b)
-{
-    return fixed(a)>b;
-}
-inline bool operator>(short a, fixed const& b)
-{
-    return fixed(a)>b;
-}
-inline bool operator>(unsigned char a, fixed const& b)
-{
-    return fixed(a)>b;
-}
-inline bool operator>(char a, fixed const& b)
-{
-    return fixed(a)>b;
-}
-
-inline bool operator>(fixed const& a,double b)
-{
-    return a>fixed(b);
-}
-inline bool operator>(fixed const& a,float b)
-{
-    return a>fixed(b);
-}
-inline bool operator>(fixed const& a,unsigned long b)
-{
-    return a>fixed(b);
-}
-inline bool operator>(fixed const& a,long b)
-{
-    return a>fixed(b);
-}
-inline bool operator>(fixed const& a,unsigned b)
-{
-    return a>fixed(b);
-}
-inline bool operator>(fixed const& a,int b)
-{
-    return a>fixed(b);
-}
-inline bool operator>(fixed const& a,unsigned short b)
-{
-    return a>fixed(b);
-}
-inline bool operator>(fixed const& a,short b)
-{
-    return a>fixed(b);
-}
-inline bool operator>(fixed const& a,unsigned char b)
-{
-    return a>fixed(b);
-}
-inline bool operator>(fixed const& a,char b)
-{
-    return a>fixed(b);
-}
-
-inline bool operator<=(double a, fixed const& b)
-{
-    return fixed(a)<=b;
-}
-inline bool operator<=(float a, fixed const& b)
-{
-    return fixed(a)<=b;
-}
-
-inline bool operator<=(unsigned long a, fixed const& b)
-{
-    return fixed(a)<=b;
-}
-inline bool operator<=(long a, fixed const& b)
-{
-    return fixed(a)<=b;
-}
-inline bool operator<=(unsigned a, fixed const& b)
-{
-    return fixed(a)<=b;
-}
-inline bool operator<=(int a, fixed const& b)
-{
-    return fixed(a)<=b;
-}
-inline bool operator<=(unsigned short a, fixed const& b)
-{
-    return fixed(a)<=b;
-}
-inline bool operator<=(short a, fixed const& b)
-{
-    return fixed(a)<=b;
-}
-inline bool operator<=(unsigned char a, fixed const& b)
-{
-    return fixed(a)<=b;
-}
-inline bool operator<=(char a, fixed const& b)
-{
-    return fixed(a)<=b;
-}
-
-inline bool operator<=(fixed const& a,double b)
-{
-    return a<=fixed(b);
-}
-inline bool operator<=(fixed const& a,float b)
-{
-    return a<=fixed(b);
-}
-inline bool operator<=(fixed const& a,unsigned long b)
-{
-    return a<=fixed(b);
-}
-inline bool operator<=(fixed const& a,long b)
-{
-    return a<=fixed(b);
-}
-inline bool operator<=(fixed const& a,unsigned b)
-{
-    return a<=fixed(b);
-}
-inline bool operator<=(fixed const& a,int b)
-{
-    return a<=fixed(b);
-}
-inline bool operator<=(fixed const& a,unsigned short b)
-{
-    return a<=fixed(b);
-}
-inline bool operator<=(fixed const& a,short b)
-{
-    return a<=fixed(b);
-}
-inline bool operator<=(fixed const& a,unsigned char b)
-{
-    return a<=fixed(b);
-}
-inline bool operator<=(fixed const& a,char b)
-{
-    return a<=fixed(b);
-}
-
-inline bool operator>=(double a, fixed const& b)
-{
-    return fixed(a)>=b;
-}
-inline bool operator>=(float a, fixed const& b)
-{
-    return fixed(a)>=b;
-}
-
-inline bool operator>=(unsigned long a, fixed const& b)
-{
-    return fixed(a)>=b;
-}
-inline bool operator>=(long a, fixed const& b)
-{
-    return fixed(a)>=b;
-}
-inline bool operator>=(unsigned a, fixed const& b)
-{
-    return fixed(a)>=b;
-}
-inline bool operator>=(int a, fixed const& b)
-{
-    return fixed(a)>=b;
-}
-inline bool operator>=(unsigned short a, fixed const& b)
-{
-    return fixed(a)>=b;
-}
-inline bool operator>=(short a, fixed const& b)
-{
-    return fixed(a)>=b;
-}
-inline bool operator>=(unsigned char a, fixed const& b)
-{
-    return fixed(a)>=b;
-}
-inline bool operator>=(char a, fixed const& b)
-{
-    return fixed(a)>=b;
-}
-
-inline bool operator>=(fixed const& a,double b)
-{
-    return a>=fixed(b);
-}
-inline bool operator>=(fixed const& a,float b)
-{
-    return a>=fixed(b);
-}
-inline bool operator>=(fixed const& a,unsigned long b)
-{
-    return a>=fixed(b);
-}
-inline bool operator>=(fixed const& a,long b)
-{
-    return a>=fixed(b);
-}
-inline bool operator>=(fixed const& a,unsigned b)
-{
-    return a>=fixed(b);
-}
-inline bool operator>=(fixed const& a,int b)
-{
-    return a>=fixed(b);
-}
-inline bool operator>=(fixed const& a,unsigned short b)
-{
-    return a>=fixed(b);
-}
-inline bool operator>=(fixed const& a,short b)
-{
-    return a>=fixed(b);
-}
-inline bool operator>=(fixed const& a,unsigned char b)
-{
-    return a>=fixed(b);
-}
-inline bool operator>=(fixed const& a,char b)
-{
-    return a>=fixed(b);
-}
-
-inline fixed sin(fixed const& x)
-{
-    return x.sin();
-}
-inline fixed cos(fixed const& x)
-{
-    return x.cos();
-}
-inline fixed tan(fixed const& x)
-{
-    return x.tan();
-}
-
-inline fixed sqrt(fixed const& x)
-{
-    return x.sqrt();
-}
-
-inline fixed exp(fixed const& x)
-{
-    return x.exp();
-}
-
-inline fixed log(fixed const& x)
-{
-    return x.log();
-}
-
-inline fixed floor(fixed const& x)
-{
-    return x.floor();
-}
-
-inline fixed ceil(fixed const& x)
-{
-    return x.ceil();
-}
-
-inline fixed abs(fixed const& x)
-{
-    return x.abs();
-}
-
-inline fixed modf(fixed const& x,fixed*integral_part)
-{
-    return x.modf(integral_part);
-}
-
-inline fixed fixed::ceil() const
-{
-    if(m_nVal%fixed_resolution)
-    {
-        return floor()+1;
-    }
-    else
-    {
-        return *this;
-    }
-}
-
-inline fixed fixed::floor() const
-{
-    fixed res(*this);
-    __int64 const remainder=m_nVal%fixed_resolution;
-    if(remainder)
-    {
-        res.m_nVal-=remainder;
-        if(m_nVal<0)
-        {
-            res-=1;
-        }
-    }
-    return res;
-}
-
-
-inline fixed fixed::sin() const
-{
-    fixed res;
-    sin_cos(*this,&res,0);
-    return res;
-}
-
-inline fixed fixed::cos() const
-{
-    fixed res;
-    sin_cos(*this,0,&res);
-    return res;
-}
-
-inline fixed fixed::tan() const
-{
-    fixed s,c;
-    sin_cos(*this,&s,&c);
-    return s/c;
-}
-
-inline fixed fixed::operator-() const
-{
-    return fixed(internal(),-m_nVal);
-}
-
-inline fixed fixed::abs() const
-{
-    return fixed(internal(),m_nVal<0?-m_nVal:m_nVal);
-}
-
-inline fixed fixed::modf(fixed*integral_part) const
-{
-    __int64 fractional_part=m_nVal%fixed_resolution;
-    if(m_nVal<0 && fractional_part>0)
-    {
-        fractional_part-=fixed_resolution;
-    }
-    integral_part->m_nVal=m_nVal-fractional_part;
-    return fixed(internal(),fractional_part);
-}
-
-namespace std
-{
-    template<>
-    inline ::fixed arg(const std::complex<::fixed>& val)
-    {
-        ::fixed r,theta;
-        ::fixed::to_polar(val.real(),val.imag(),&r,&theta);
-        return theta;
-    }
-
-    template<>
-    inline complex<::fixed> polar(::fixed const& rho,::fixed const& theta)
-    {
-        ::fixed s,c;
-        ::fixed::sin_cos(theta,&s,&c);
-        return complex<::fixed>(rho * c, rho * s);
-    }
-}
-
-fixed const fixed_max(fixed::internal(),0x7fffffffffffffffI64);
-fixed const fixed_one(fixed::internal(),1I64<<(fixed_resolution_shift));
-fixed const fixed_zero(fixed::internal(),0);
-fixed const fixed_half(fixed::internal(),1I64<<(fixed_resolution_shift-1));
-extern fixed const fixed_pi;
-extern fixed const fixed_two_pi;
-extern fixed const fixed_half_pi;
-extern fixed const fixed_quarter_pi;
-
-#endif
+#ifndef FIXED_HPP
+#define FIXED_HPP
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// (C) Copyright 2007 Anthony Williams
+
+#include <cstddef>
+#include <ostream>
+#include <istream>
+#include <complex>
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+#include <intrin.h>
+#endif
+
+// Build options, to be defined when compiling fixed.cpp:
+//   FIXED_PORTABLE_MULTIPLY  use the split-word multiply even where the
+//                            compiler offers a 64x64->128 bit product
+//   FIXED_ROUND_MULTIPLY     round products to nearest instead of truncating.
+//                            Products formed at compile time honour it too,
+//                            so define it for every translation unit.
+//   FIXED_PORTABLE_DIVIDE    use chunked long division even where the
+//                            hardware has a 128/64 bit divide
+//   FIXED_FAST_EXP_LOG       compute exp() and log() by range reduction and a
+//                            short polynomial in constant time instead of
+//                            walking the log tables. For Q35.28 log() is
+//                            within 0.5 ulp (tables: 3.7) and exp() within
+//                            0.5 ulp or 2^-48 relative, whichever is larger
+//                            (tables: 4e-8 relative).
+//   FIXED_TABLE_TRIG         compute sin_cos() from a quarter-wave sine table
+//                            instead of CORDIC; about 8x faster. The table
+//                            has 2^FIXED_TRIG_TABLE_BITS intervals (default
+//                            9, i.e. 4KB) and is interpolated with a second
+//                            order step from the nearest entry. For
+//                            |x|<=2*pi, Q35.28 results are within 1.2 ulp
+//                            (CORDIC: 5.7) and Q15.16 within 1.4 ulp.
+//   FIXED_TRIG_LINEAR        interpolate the table linearly instead; about
+//                            1.4x faster again but the error is h^2/8 for an
+//                            interval of h radians: 316 ulp for Q35.28 with
+//                            the default table, still 1.4 ulp for Q15.16.
+//   FIXED_PORTABLE_BATCH     use plain loops for fixed_mul() and the other
+//                            batch functions, leaving out the SSE4.2, AVX2
+//                            and AVX-512 kernels and the processor check
+//   FIXED_NO_FLOATING_POINT  leave out everything that takes, returns or
+//                            computes with float or double: those
+//                            constructors, conversions and mixed operators,
+//                            fit_minimax() and the float and double
+//                            fixed_convert(). operator<< then prints from
+//                            the exact decimal value using integers, so the
+//                            library builds with GCC's -mgeneral-regs-only
+//                            and needs no soft-float routines. Define it
+//                            for every translation unit.
+//   FIXED_HEADER_ONLY        compile fixed.cpp as part of this header so
+//                            nothing is built or linked separately; unlike
+//                            the others, define it for every translation
+//                            unit.
+//
+// With C++11 the constructors, comparisons, conversions and constants are
+// constexpr, and with C++14 so is the rest of the inline arithmetic. Products
+// and quotients also need the compiler to say when it is evaluating a
+// constant (GCC 9, Clang 9, MSVC 19.25 or later); they then use a portable
+// path with the same results as the runtime one. Named constants are
+// constant-initialized, so there is no dynamic initialization at startup;
+// where products are constexpr, that includes the FIXED_TABLE_TRIG table.
+//
+// Where products are constexpr, sqrt(), exp(), log(), sin_cos() and
+// to_polar() are too in a FIXED_HEADER_ONLY build, the only one where their
+// definitions are visible. They run the same code as at runtime, so tables
+// of their results can be generated at compile time with identical values.
+// With FIXED_TABLE_TRIG this needs FIXED_TRIG_TABLE_BITS of at most 14.
+
+#if (defined(__cplusplus) && (__cplusplus>=201103L)) || (defined(_MSC_VER) && (_MSC_VER>=1900))
+#define FIXED_CONSTEXPR constexpr
+#else
+#define FIXED_CONSTEXPR
+#endif
+
+#if (defined(__cplusplus) && (__cplusplus>=201402L)) || (defined(_MSVC_LANG) && (_MSVC_LANG>=201402L))
+#define FIXED_CONSTEXPR14 constexpr
+#else
+#define FIXED_CONSTEXPR14
+#endif
+
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define FIXED_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#endif
+#if !defined(FIXED_IS_CONSTANT_EVALUATED)
+#if (defined(__GNUC__) && !defined(__clang__) && (__GNUC__>=9)) || (defined(_MSC_VER) && (_MSC_VER>=1925))
+#define FIXED_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#endif
+
+// Code with a faster runtime path, such as a hardware multiply, can only
+// be constexpr where the compiler says which one to take
+#if defined(FIXED_IS_CONSTANT_EVALUATED)
+#define FIXED_CONSTEXPR_ARITHMETIC FIXED_CONSTEXPR14
+#else
+#define FIXED_IS_CONSTANT_EVALUATED() false
+#define FIXED_CONSTEXPR_ARITHMETIC
+#endif
+
+#if defined(FIXED_HEADER_ONLY)
+#define FIXED_CONSTEXPR_MATH FIXED_CONSTEXPR_ARITHMETIC
+#define FIXED_INLINE inline
+#else
+#define FIXED_CONSTEXPR_MATH
+#define FIXED_INLINE
+#endif
+
+unsigned const fixed_resolution_shift=28;
+__int64 const fixed_resolution=1I64<<fixed_resolution_shift;
+
+// Number of CORDIC steps used by sin_cos(), to_polar() and atan() unless the
+// caller asks for fewer. Each step adds about one bit of precision, so a
+// caller needing n bits of angle can pass n+2 and run proportionally faster.
+unsigned const fixed_cordic_iterations=30;
+
+// Properties of the integer types a basic_fixed can be stored in.
+template<typename StorageInt>
+struct fixed_storage_traits;
+
+template<>
+struct fixed_storage_traits<int>
+{
+    typedef unsigned int unsigned_type;
+    static unsigned const bits=32;
+    static int const max_value=0x7fffffff;
+};
+
+template<>
+struct fixed_storage_traits<__int64>
+{
+    typedef unsigned __int64 unsigned_type;
+    static unsigned const bits=64;
+    static __int64 const max_value=0x7fffffffffffffffI64;
+};
+
+// pi in Q61; every format truncates its constants from this
+unsigned __int64 const fixed_pi_q61=0x6487ED5110B4611AI64;
+
+template<typename StorageInt,unsigned FracBits>
+struct fixed_constants
+{
+    static StorageInt const internal_pi=StorageInt(fixed_pi_q61>>(61-FracBits));
+    static StorageInt const internal_two_pi=StorageInt(fixed_pi_q61>>(60-FracBits));
+    static StorageInt const internal_half_pi=StorageInt(fixed_pi_q61>>(62-FracBits));
+    static StorageInt const internal_quarter_pi=StorageInt(fixed_pi_q61>>(63-FracBits));
+};
+
+#ifdef FIXED_ROUND_MULTIPLY
+bool const fixed_round_multiply=true;
+#else
+bool const fixed_round_multiply=false;
+#endif
+
+// Multiply and divide of magnitudes in plain integer arithmetic, usable in
+// constant expressions. The multiply drops FracBits from the product,
+// rounding to nearest if FIXED_ROUND_MULTIPLY is defined, and splits self
+// into halves so no partial product needs more than one word; it therefore
+// needs FracBits to fit in a half word. The divide gives the truncated
+// quotient with FracBits of extra precision, or max_value if that does not
+// fit. fixed.cpp replaces these with hardware paths where it can.
+template<typename StorageInt,unsigned FracBits>
+struct fixed_portable_arithmetic
+{
+    typedef typename fixed_storage_traits<StorageInt>::unsigned_type unsigned_type;
+    static unsigned const half_bits=fixed_storage_traits<StorageInt>::bits/2;
+    typedef char frac_bits_must_fit_in_half_word[(FracBits<=half_bits)?1:-1];
+
+    static FIXED_CONSTEXPR14 unsigned_type multiply(unsigned_type self,unsigned_type other)
+    {
+        unsigned_type const lower_mask=(unsigned_type(1)<<half_bits)-1;
+        unsigned_type const round_bias=fixed_round_multiply?(unsigned_type(1)<<(FracBits-1)):0;
+        unsigned_type res=0;
+
+        if(unsigned_type const self_upper=(self>>half_bits))
+        {
+            res=(self_upper*other)<<(half_bits-FracBits);
+        }
+        if(unsigned_type const self_lower=(self&lower_mask))
+        {
+            unsigned_type const other_upper=other>>half_bits;
+            unsigned_type const other_lower=other&lower_mask;
+            unsigned_type const lower_self_upper_other_res=self_lower*other_upper;
+            unsigned_type const lower_self_lower_other_res=self_lower*other_lower;
+            // only the last partial product has bits below the point,
+            // and it cannot carry out of a word when the bias is added
+            res+=(lower_self_upper_other_res<<(half_bits-FracBits))
+                + ((lower_self_lower_other_res+round_bias)>>FracBits);
+        }
+        return res;
+    }
+
+    // one quotient bit per step; the remainder is below b, so a bit
+    // shifted out of the top means it now exceeds b
+    static FIXED_CONSTEXPR14 unsigned_type divide(unsigned_type a,unsigned_type b)
+    {
+        unsigned_type const max_quotient=fixed_storage_traits<StorageInt>::max_value;
+        unsigned_type quotient=a/b;
+        if(quotient>(max_quotient>>FracBits))
+        {
+            return max_quotient;
+        }
+        unsigned_type remainder=a%b;
+        for(unsigned i=0;i<FracBits;++i)
+        {
+            bool const carry=(remainder>>(fixed_storage_traits<StorageInt>::bits-1))!=0;
+            remainder<<=1;
+            quotient<<=1;
+            if(carry || (remainder>=b))
+            {
+                remainder-=b;
+                quotient|=1;
+            }
+        }
+        return quotient;
+    }
+};
+
+// 32-bit formats can form the whole product and dividend in 64 bits
+template<unsigned FracBits>
+struct fixed_portable_arithmetic<int,FracBits>
+{
+    static FIXED_CONSTEXPR14 unsigned int multiply(unsigned int self,unsigned int other)
+    {
+        unsigned __int64 const round_bias=fixed_round_multiply?(1I64<<(FracBits-1)):0;
+        return (unsigned int)(((unsigned __int64)self*other+round_bias)>>FracBits);
+    }
+
+    static FIXED_CONSTEXPR14 unsigned int divide(unsigned int a,unsigned int b)
+    {
+        unsigned __int64 const quotient=((unsigned __int64)a<<FracBits)/b;
+        return (quotient>0x7fffffff)?0x7fffffff:(unsigned int)quotient;
+    }
+};
+
+// A polynomial coefficient value*2^-frac_bits. Each has its own binary
+// point, which is also that of the partial sum it starts in Horner's
+// scheme, so small high-order terms keep their precision.
+struct fixed_coefficient
+{
+    __int64 value;
+    unsigned frac_bits;
+};
+
+// Signed 128-bit product: returns the upper word and stores the lower
+inline FIXED_CONSTEXPR_ARITHMETIC __int64 fixed_multiply_wide(__int64 lhs,__int64 rhs,unsigned __int64* lower)
+{
+#if defined(__SIZEOF_INT128__) && !defined(FIXED_PORTABLE_MULTIPLY)
+    __int128 const product=(__int128)lhs*rhs;
+    *lower=(unsigned __int64)product;
+    return (__int64)(product>>64);
+#else
+    *lower=(unsigned __int64)lhs*(unsigned __int64)rhs;
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64)) && !defined(FIXED_PORTABLE_MULTIPLY)
+    if(!FIXED_IS_CONSTANT_EVALUATED())
+    {
+        return __mulh(lhs,rhs);
+    }
+#endif
+    unsigned __int64 const lhs_upper=(unsigned __int64)lhs>>32;
+    unsigned __int64 const lhs_lower=(unsigned __int64)lhs&0xffffffff;
+    unsigned __int64 const rhs_upper=(unsigned __int64)rhs>>32;
+    unsigned __int64 const rhs_lower=(unsigned __int64)rhs&0xffffffff;
+    unsigned __int64 const upper_lower=lhs_upper*rhs_lower;
+    unsigned __int64 const lower_upper=lhs_lower*rhs_upper;
+    unsigned __int64 const middle=((lhs_lower*rhs_lower)>>32)+(upper_lower&0xffffffff)+(lower_upper&0xffffffff);
+    unsigned __int64 upper=lhs_upper*rhs_upper+(upper_lower>>32)+(lower_upper>>32)+(middle>>32);
+    // the unsigned product of the two's complement words is 2^64 times
+    // each negative operand's partner too large
+    if(lhs<0)
+    {
+        upper-=(unsigned __int64)rhs;
+    }
+    if(rhs<0)
+    {
+        upper-=(unsigned __int64)lhs;
+    }
+    return (__int64)upper;
+#endif
+}
+
+// Signed 128-bit product shifted right by shift bits, or left if negative,
+// truncated to 64 bits
+inline FIXED_CONSTEXPR_ARITHMETIC __int64 fixed_multiply_shift(__int64 lhs,__int64 rhs,int shift)
+{
+    unsigned __int64 lower=0;
+    __int64 const upper=fixed_multiply_wide(lhs,rhs,&lower);
+    if(shift<=0)
+    {
+        return (__int64)(lower<<-shift);
+    }
+    if(shift<64)
+    {
+        return (__int64)(((unsigned __int64)upper<<(64-shift))|(lower>>shift));
+    }
+    return upper>>((shift<127)?(shift-64):63);
+}
+
+// floor(log2(N))
+template<unsigned N>
+struct fixed_log2
+{
+    static unsigned const value=1+fixed_log2<N/2>::value;
+};
+
+template<>
+struct fixed_log2<1>
+{
+    static unsigned const value=0;
+};
+
+// Sums of Count coefficients at wide precision, unrolled at compile time so
+// that coefficient formats known at compile time become constant shifts.
+// Each partial sum is in the format of its lowest coefficient.
+template<unsigned Count>
+struct fixed_polynomial
+{
+    // Estrin's scheme splits off the largest power of two of terms below
+    // Count and multiplies the rest by x to that power, powers[level], held
+    // with x_frac_bits for x itself and power_frac_bits for its squares
+    static unsigned const level=fixed_log2<Count-1>::value;
+    static unsigned const split=1u<<level;
+    static unsigned const levels=level+1;
+
+    static FIXED_CONSTEXPR_ARITHMETIC __int64 horner(fixed_coefficient const* coefficients,__int64 x,unsigned x_frac_bits)
+    {
+        __int64 const upper=fixed_polynomial<Count-1>::horner(coefficients+1,x,x_frac_bits);
+        int const shift=int(coefficients[1].frac_bits+x_frac_bits)-int(coefficients[0].frac_bits);
+        return coefficients[0].value+fixed_multiply_shift(upper,x,shift);
+    }
+
+    static FIXED_CONSTEXPR_ARITHMETIC __int64 estrin(fixed_coefficient const* coefficients,__int64 const* powers,unsigned x_frac_bits,unsigned power_frac_bits)
+    {
+        __int64 const lower=fixed_polynomial<split>::estrin(coefficients,powers,x_frac_bits,power_frac_bits);
+        __int64 const upper=fixed_polynomial<Count-split>::estrin(coefficients+split,powers,x_frac_bits,power_frac_bits);
+        int const shift=int(coefficients[split].frac_bits+(level?power_frac_bits:x_frac_bits))-int(coefficients[0].frac_bits);
+        return lower+fixed_multiply_shift(upper,powers[level],shift);
+    }
+};
+
+template<>
+struct fixed_polynomial<1>
+{
+    static unsigned const levels=1;
+
+    static FIXED_CONSTEXPR __int64 horner(fixed_coefficient const* coefficients,__int64,unsigned)
+    {
+        return coefficients[0].value;
+    }
+
+    static FIXED_CONSTEXPR __int64 estrin(fixed_coefficient const* coefficients,__int64 const*,unsigned,unsigned)
+    {
+        return coefficients[0].value;
+    }
+};
+
+template<typename UnsignedInt>
+class basic_fixed_angle;
+
+template<typename Function,unsigned N,typename Interp>
+class fixed_lut;
+
+template<typename StorageInt,unsigned FracBits>
+class basic_fixed_accumulator;
+
+// Fixed point number held in a StorageInt with FracBits fractional bits.
+// The arithmetic and transcendental functions are defined in fixed.cpp and
+// instantiated there for the formats typedef'd at the end of this header,
+// or for any format in use when built with FIXED_HEADER_ONLY.
+template<typename StorageInt,unsigned FracBits>
+class basic_fixed
+{
+private:
+    StorageInt m_nVal;
+
+    static FIXED_CONSTEXPR_MATH void sin_cos_turns(unsigned __int64 turns,basic_fixed* s,basic_fixed*c,unsigned iterations);
+    static FIXED_CONSTEXPR_MATH void to_polar_turns(basic_fixed const& x,basic_fixed const& y,basic_fixed* r,unsigned __int64* turns,unsigned iterations);
+    basic_fixed inverse_sine(bool cosine) const;
+    // the runtime operator*= and operator/=, defined in fixed.cpp
+    basic_fixed& multiply(basic_fixed const& val);
+    basic_fixed& divide(basic_fixed const& divisor);
+    // a wide polynomial sum with frac_bits, rounded to this format
+    static FIXED_CONSTEXPR14 basic_fixed from_wide(__int64 val,unsigned frac_bits);
+
+    // indexes its table straight from the representation
+    template<typename Function,unsigned N,typename Interp>
+    friend class fixed_lut;
+    friend class basic_fixed_accumulator<StorageInt,FracBits>;
+
+public:
+    typedef StorageInt storage_type;
+    typedef typename fixed_storage_traits<StorageInt>::unsigned_type unsigned_storage_type;
+
+    static unsigned const resolution_shift=FracBits;
+    static StorageInt const resolution=StorageInt(1)<<FracBits;
+
+    struct internal
+    {};
+
+    FIXED_CONSTEXPR basic_fixed():
+        m_nVal(0)
+    {}
+    
+    FIXED_CONSTEXPR basic_fixed(internal, StorageInt nVal):
+        m_nVal(nVal)
+    {}
+    FIXED_CONSTEXPR basic_fixed(__int64 nVal):
+        m_nVal(StorageInt(unsigned_storage_type(nVal)<<FracBits))
+    {}
+    
+    FIXED_CONSTEXPR basic_fixed(long nVal):
+        m_nVal(StorageInt(unsigned_storage_type(nVal)<<FracBits))
+    {}
+    
+    FIXED_CONSTEXPR basic_fixed(int nVal):
+        m_nVal(StorageInt(unsigned_storage_type(nVal)<<FracBits))
+    {}
+    
+    FIXED_CONSTEXPR basic_fixed(short nVal):
+        m_nVal(StorageInt(unsigned_storage_type(nVal)<<FracBits))
+    {}
+    
+    FIXED_CONSTEXPR basic_fixed(unsigned __int64 nVal):
+        m_nVal(StorageInt(unsigned_storage_type(nVal)<<FracBits))
+    {}
+    
+    FIXED_CONSTEXPR basic_fixed(unsigned long nVal):
+        m_nVal(StorageInt(unsigned_storage_type(nVal)<<FracBits))
+    {}
+    FIXED_CONSTEXPR basic_fixed(unsigned int nVal):
+        m_nVal(StorageInt(unsigned_storage_type(nVal)<<FracBits))
+    {}
+    FIXED_CONSTEXPR basic_fixed(unsigned short nVal):
+        m_nVal(StorageInt(unsigned_storage_type(nVal)<<FracBits))
+    {}
+#if !defined(FIXED_NO_FLOATING_POINT)
+    FIXED_CONSTEXPR basic_fixed(double nVal):
+        m_nVal(static_cast<StorageInt>(nVal*static_cast<double>(resolution)))
+    {}
+    FIXED_CONSTEXPR basic_fixed(float nVal):
+        m_nVal(static_cast<StorageInt>(nVal*static_cast<float>(resolution)))
+    {}
+#endif
+
+    template<typename T>
+    FIXED_CONSTEXPR14 basic_fixed& operator=(T other)
+    {
+        m_nVal=basic_fixed(other).m_nVal;
+        return *this;
+    }
+    FIXED_CONSTEXPR14 basic_fixed& operator=(basic_fixed const& other)
+    {
+        m_nVal=other.m_nVal;
+        return *this;
+    }
+    friend FIXED_CONSTEXPR bool operator==(basic_fixed const& lhs,basic_fixed const& rhs)
+    {
+        return lhs.m_nVal==rhs.m_nVal;
+    }
+    friend FIXED_CONSTEXPR bool operator!=(basic_fixed const& lhs,basic_fixed const& rhs)
+    {
+        return lhs.m_nVal!=rhs.m_nVal;
+    }
+    friend FIXED_CONSTEXPR bool operator<(basic_fixed const& lhs,basic_fixed const& rhs)
+    {
+        return lhs.m_nVal<rhs.m_nVal;
+    }
+    friend FIXED_CONSTEXPR bool operator>(basic_fixed const& lhs,basic_fixed const& rhs)
+    {
+        return lhs.m_nVal>rhs.m_nVal;
+    }
+    friend FIXED_CONSTEXPR bool operator<=(basic_fixed const& lhs,basic_fixed const& rhs)
+    {
+        return lhs.m_nVal<=rhs.m_nVal;
+    }
+    friend FIXED_CONSTEXPR bool operator>=(basic_fixed const& lhs,basic_fixed const& rhs)
+    {
+        return lhs.m_nVal>=rhs.m_nVal;
+    }
+    FIXED_CONSTEXPR operator bool() const
+    {
+        return m_nVal?true:false;
+    }
+#if !defined(FIXED_NO_FLOATING_POINT)
+    FIXED_CONSTEXPR operator double() const
+    {
+        return as_double();
+    }
+    FIXED_CONSTEXPR float as_float() const
+    {
+        return m_nVal/(float)resolution;
+    }
+
+    FIXED_CONSTEXPR double as_double() const
+    {
+        return m_nVal/(double)resolution;
+    }
+#endif
+
+    // The IEEE 754 bit patterns of as_double() and as_float(), and the
+    // values of such patterns truncated as basic_fixed(double) and
+    // basic_fixed(float) do, but saturating and taking NaN to zero. All
+    // four use integers only.
+    unsigned __int64 as_double_bits() const;
+    unsigned as_float_bits() const;
+    static basic_fixed from_double_bits(unsigned __int64 bits);
+    static basic_fixed from_float_bits(unsigned bits);
+
+    FIXED_CONSTEXPR long as_long() const
+    {
+        return (long)(m_nVal/resolution);
+    }
+    FIXED_CONSTEXPR __int64 as_int64() const
+    {
+        return m_nVal/resolution;
+    }
+
+    FIXED_CONSTEXPR int as_int() const
+    {
+        return (int)(m_nVal/resolution);
+    }
+
+    FIXED_CONSTEXPR unsigned long as_unsigned_long() const
+    {
+        return (unsigned long)(m_nVal/resolution);
+    }
+    FIXED_CONSTEXPR unsigned __int64 as_unsigned_int64() const
+    {
+        return (unsigned __int64)m_nVal/resolution;
+    }
+
+    FIXED_CONSTEXPR unsigned int as_unsigned_int() const
+    {
+        return (unsigned int)(m_nVal/resolution);
+    }
+
+    FIXED_CONSTEXPR short as_short() const
+    {
+        return (short)(m_nVal/resolution);
+    }
+
+    FIXED_CONSTEXPR unsigned short as_unsigned_short() const
+    {
+        return (unsigned short)(m_nVal/resolution);
+    }
+
+    FIXED_CONSTEXPR14 basic_fixed operator++()
+    {
+        m_nVal += resolution;
+        return *this;
+    }
+
+    FIXED_CONSTEXPR14 basic_fixed operator--()
+    {
+        m_nVal -= resolution;
+        return *this;
+    }
+
+    FIXED_CONSTEXPR14 basic_fixed floor() const;
+    FIXED_CONSTEXPR14 basic_fixed ceil() const;
+    FIXED_CONSTEXPR_MATH basic_fixed sqrt() const;
+    static basic_fixed hypot(basic_fixed const& x,basic_fixed const& y);
+    static basic_fixed hypot(basic_fixed const& x,basic_fixed const& y,basic_fixed const& z);
+    basic_fixed reciprocal() const;
+    basic_fixed rsqrt() const;
+    FIXED_CONSTEXPR_MATH basic_fixed exp() const;
+    FIXED_CONSTEXPR_MATH basic_fixed log() const;
+    basic_fixed exp2() const;
+    basic_fixed log2() const;
+    basic_fixed pow(basic_fixed const& y) const;
+    basic_fixed pown(int n) const;
+    FIXED_CONSTEXPR14 basic_fixed& operator%=(basic_fixed const& other)
+    {
+        m_nVal = m_nVal%other.m_nVal;
+        return *this;
+    }
+    FIXED_CONSTEXPR_ARITHMETIC basic_fixed& operator*=(basic_fixed const& val)
+    {
+        if(FIXED_IS_CONSTANT_EVALUATED())
+        {
+            bool const negate=(m_nVal<0) ^ (val.m_nVal<0);
+            unsigned_storage_type const self=(m_nVal<0)?0-unsigned_storage_type(m_nVal):m_nVal;
+            unsigned_storage_type const other=(val.m_nVal<0)?0-unsigned_storage_type(val.m_nVal):val.m_nVal;
+            unsigned_storage_type const res=fixed_portable_arithmetic<StorageInt,FracBits>::multiply(self,other);
+            m_nVal=StorageInt(negate?0-res:res);
+            return *this;
+        }
+        return multiply(val);
+    }
+    FIXED_CONSTEXPR_ARITHMETIC basic_fixed& operator/=(basic_fixed const& val)
+    {
+        if(FIXED_IS_CONSTANT_EVALUATED())
+        {
+            if(!val.m_nVal)
+            {
+                m_nVal=fixed_storage_traits<StorageInt>::max_value;
+                return *this;
+            }
+            bool const negate=(m_nVal<0) ^ (val.m_nVal<0);
+            unsigned_storage_type const a=(m_nVal<0)?0-unsigned_storage_type(m_nVal):m_nVal;
+            unsigned_storage_type const b=(val.m_nVal<0)?0-unsigned_storage_type(val.m_nVal):val.m_nVal;
+            unsigned_storage_type const res=fixed_portable_arithmetic<StorageInt,FracBits>::divide(a,b);
+            m_nVal=negate?-StorageInt(res):StorageInt(res);
+            return *this;
+        }
+        return divide(val);
+    }
+    FIXED_CONSTEXPR14 basic_fixed& operator-=(basic_fixed const& val)
+    {
+        m_nVal -= val.m_nVal;
+        return *this;
+    }
+
+    FIXED_CONSTEXPR14 basic_fixed& operator+=(basic_fixed const& val)
+    {
+        m_nVal += val.m_nVal;
+        return *this;
+    }
+#if !defined(FIXED_NO_FLOATING_POINT)
+    FIXED_CONSTEXPR14 basic_fixed& operator*=(double val)
+    {
+        return (*this)*=basic_fixed(val);
+    }
+    FIXED_CONSTEXPR14 basic_fixed& operator*=(float val)
+    {
+        return (*this)*=basic_fixed(val);
+    }
+#endif
+    FIXED_CONSTEXPR14 basic_fixed& operator*=(__int64 val)
+    {
+        m_nVal*=val;
+        return *this;
+    }
+    FIXED_CONSTEXPR14 basic_fixed& operator*=(long val)
+    {
+        m_nVal*=val;
+        return *this;
+    }
+    FIXED_CONSTEXPR14 basic_fixed& operator*=(int val)
+    {
+        m_nVal*=val;
+        return *this;
+    }
+    FIXED_CONSTEXPR14 basic_fixed& operator*=(short val)
+    {
+        m_nVal*=val;
+        return *this;
+    }
+    FIXED_CONSTEXPR14 basic_fixed& operator*=(char val)
+    {
+        m_nVal*=val;
+        return *this;
+    }
+    FIXED_CONSTEXPR14 basic_fixed& operator*=(unsigned __int64 val)
+    {
+        m_nVal*=val;
+        return *this;
+    }
+    FIXED_CONSTEXPR14 basic_fixed& operator*=(unsigned long val)
+    {
+        m_nVal*=val;
+        return *this;
+    }
+    FIXED_CONSTEXPR14 basic_fixed& operator*=(unsigned int val)
+    {
+        m_nVal*=val;
+        return *this;
+    }
+    FIXED_CONSTEXPR14 basic_fixed& operator*=(unsigned short val)
+    {
+        m_nVal*=val;
+        return *this;
+    }
+    FIXED_CONSTEXPR14 basic_fixed& operator*=(unsigned char val)
+    {
+        m_nVal*=val;
+        return *this;
+    }
+#if !defined(FIXED_NO_FLOATING_POINT)
+    FIXED_CONSTEXPR14 basic_fixed& operator/=(double val)
+    {
+        return (*this)/=basic_fixed(val);
+    }
+    FIXED_CONSTEXPR14 basic_fixed& operator/=(float val)
+    {
+        return (*this)/=basic_fixed(val);
+    }
+#endif
+    FIXED_CONSTEXPR14 basic_fixed& operator/=(__int64 val)
+    {
+        m_nVal/=val;
+        return *this;
+    }
+    FIXED_CONSTEXPR14 basic_fixed& operator/=(long val)
+    {
+        m_nVal/=val;
+        return *this;
+    }
+    FIXED_CONSTEXPR14 basic_fixed& operator/=(int val)
+    {
+        m_nVal/=val;
+        return *this;
+    }
+    FIXED_CONSTEXPR14 basic_fixed& operator/=(short val)
+    {
+        m_nVal/=val;
+        return *this;
+    }
+    FIXED_CONSTEXPR14 basic_fixed& operator/=(char val)
+    {
+        m_nVal/=val;
+        return *this;
+    }
+    FIXED_CONSTEXPR14 basic_fixed& operator/=(unsigned __int64 val)
+    {
+        m_nVal/=val;
+        return *this;
+    }
+    FIXED_CONSTEXPR14 basic_fixed& operator/=(unsigned long val)
+    {
+        m_nVal/=val;
+        return *this;
+    }
+    FIXED_CONSTEXPR14 basic_fixed& operator/=(unsigned int val)
+    {
+        m_nVal/=val;
+        return *this;
+    }
+    FIXED_CONSTEXPR14 basic_fixed& operator/=(unsigned short val)
+    {
+        m_nVal/=val;
+        return *this;
+    }
+    FIXED_CONSTEXPR14 basic_fixed& operator/=(unsigned char val)
+    {
+        m_nVal/=val;
+        return *this;
+    }
+    
+
+    FIXED_CONSTEXPR bool operator!() const
+    {
+        return m_nVal==0;
+    }
+    
+    FIXED_CONSTEXPR14 basic_fixed modf(basic_fixed* integral_part) const;
+    // iterations is clamped to [1,fixed_cordic_iterations]; sin_cos()
+    // ignores it when built with FIXED_TABLE_TRIG. atan() reaches full
+    // precision after 17 steps and gains nothing from more.
+    basic_fixed atan(unsigned iterations=fixed_cordic_iterations) const;
+
+    // Inverse trig from an angle-only CORDIC that finishes with a single
+    // division, within 0.5 ulp plus 2^-44 radians. atan2() gives
+    // (-pi,pi] and is zero at the origin; asin() and acos() saturate
+    // outside [-1,1].
+    static basic_fixed atan2(basic_fixed const& y,basic_fixed const& x);
+    static basic_fixed atan2_deg(basic_fixed const& y,basic_fixed const& x);
+    basic_fixed asin() const;
+    basic_fixed acos() const;
+
+    static FIXED_CONSTEXPR_MATH void sin_cos(basic_fixed const& theta,basic_fixed* s,basic_fixed*c,unsigned iterations=fixed_cordic_iterations);
+    static FIXED_CONSTEXPR_MATH void to_polar(basic_fixed const& x,basic_fixed const& y,basic_fixed* r,basic_fixed*theta,unsigned iterations=fixed_cordic_iterations);
+
+    // sin_cos() and to_polar() over arrays of count values, with exactly the
+    // same results. s or c may be null, and outputs may alias inputs. The
+    // CORDIC steps run on 4, 8 or 16 values at once with SSE4.2, AVX2 or
+    // AVX-512; see fixed_batch_level_in_use().
+    static void sin_cos_batch(basic_fixed const* theta,basic_fixed* s,basic_fixed* c,std::size_t count,unsigned iterations=fixed_cordic_iterations);
+    static void to_polar_batch(basic_fixed const* x,basic_fixed const* y,basic_fixed* r,basic_fixed* theta,std::size_t count,unsigned iterations=fixed_cordic_iterations);
+
+    // The same for an angle held as a fraction of a turn, which needs no
+    // range reduction
+    template<typename UnsignedInt>
+    static FIXED_CONSTEXPR_MATH void sin_cos(basic_fixed_angle<UnsignedInt> const& theta,basic_fixed* s,basic_fixed*c,unsigned iterations=fixed_cordic_iterations)
+    {
+        sin_cos_turns(theta.as_turns(),s,c,iterations);
+    }
+    template<typename UnsignedInt>
+    static FIXED_CONSTEXPR_MATH void to_polar(basic_fixed const& x,basic_fixed const& y,basic_fixed* r,basic_fixed_angle<UnsignedInt>*theta,unsigned iterations=fixed_cordic_iterations)
+    {
+        unsigned __int64 turns=0;
+        to_polar_turns(x,y,r,&turns,iterations);
+        *theta=basic_fixed_angle<UnsignedInt>::from_turns(turns);
+    }
+
+    // This angle in radians as a Q64 fraction of a turn, wrapped to [0,1),
+    // and back to radians in [-pi,pi). The round trip is exact for angles
+    // already in [-pi,pi).
+    unsigned __int64 as_turns() const;
+    static basic_fixed from_turns(unsigned __int64 turns);
+
+    // sin_cos() and to_polar() with angles in degrees. Degrees go straight
+    // to a fraction of a turn after an exact reduction modulo 360, with no
+    // radian conversion, so multiples of 90 degrees give exact results.
+    // to_polar_deg() gives degrees in [-180,180), with the angle from the
+    // kernel of atan2() rather than the CORDIC, so it is as accurate.
+    static void sin_cos_deg(basic_fixed const& theta,basic_fixed* s,basic_fixed*c,unsigned iterations=fixed_cordic_iterations);
+    static void to_polar_deg(basic_fixed const& x,basic_fixed const& y,basic_fixed* r,basic_fixed*theta,unsigned iterations=fixed_cordic_iterations);
+
+    FIXED_CONSTEXPR_MATH basic_fixed sin() const;
+    FIXED_CONSTEXPR_MATH basic_fixed cos() const;
+    FIXED_CONSTEXPR_MATH basic_fixed tan() const;
+    FIXED_CONSTEXPR basic_fixed operator-() const;
+    FIXED_CONSTEXPR basic_fixed abs() const;
+
+    // The polynomial sum of coefficients[k]*x^k. Partial sums are held in
+    // 64 bits in their coefficient's format and products are formed in 128
+    // bits, so the only rounding to this format is of the final result.
+    // Horner's scheme is the more accurate. Estrin's evaluates pairs of terms
+    // independently, so its dependency chain grows with log2 of the degree
+    // rather than the degree. It holds the powers of x exactly for 32-bit
+    // formats but only to FracBits for 64-bit ones, which costs up to an ulp
+    // of the input times the size of the higher terms.
+    template<unsigned Count>
+    static FIXED_CONSTEXPR_ARITHMETIC basic_fixed horner(fixed_coefficient const (&coefficients)[Count],basic_fixed const& x);
+    template<unsigned Count>
+    static FIXED_CONSTEXPR_ARITHMETIC basic_fixed estrin(fixed_coefficient const (&coefficients)[Count],basic_fixed const& x);
+
+    // Fits the minimax polynomial of the given degree (at most 16) to
+    // function over [lower,upper] by the Remez exchange algorithm and stores
+    // its degree+1 coefficients for horner() and estrin(). Each coefficient
+    // gets as many fractional bits as leave its partial sums a spare bit
+    // over the range, and never more than FracBits above the next, so every
+    // product is shifted right. Returns the largest absolute error of the
+    // fitted polynomial before its coefficients are rounded, or -1 if the
+    // degree or range is invalid.
+#if !defined(FIXED_NO_FLOATING_POINT)
+    static double fit_minimax(double (*function)(double),basic_fixed const& lower,basic_fixed const& upper,unsigned degree,fixed_coefficient* coefficients);
+#endif
+};
+
+template<typename StorageInt,unsigned FracBits>
+unsigned const basic_fixed<StorageInt,FracBits>::resolution_shift;
+template<typename StorageInt,unsigned FracBits>
+StorageInt const basic_fixed<StorageInt,FracBits>::resolution;
+
+#if defined(FIXED_NO_FLOATING_POINT)
+// Prints the exact value rounded as printing a double would, honouring the
+// stream's precision and its fixed, scientific, showpoint, showpos and
+// uppercase flags
+template<typename StorageInt,unsigned FracBits>
+std::ostream& operator<<(std::ostream& os,basic_fixed<StorageInt,FracBits> const& value);
+#else
+template<typename StorageInt,unsigned FracBits>
+inline std::ostream& operator<<(std::ostream& os,basic_fixed<StorageInt,FracBits> const& value)
+{
+    return os<<value.as_double();
+}
+#endif
+
+// Parses a decimal number at the start of [first,last): an optional sign,
+// digits with an optional point, and an optional exponent. Stores it
+// rounded to nearest, ties to even, saturating if out of range, and returns
+// the end of the number; or returns first and leaves value alone if there
+// is none. Uses integers only, as does operator>>, which reads the same
+// syntax.
+template<typename StorageInt,unsigned FracBits>
+char const* fixed_parse(char const* first,char const* last,basic_fixed<StorageInt,FracBits>* value);
+template<typename StorageInt,unsigned FracBits>
+std::istream& operator>>(std::istream& is,basic_fixed<StorageInt,FracBits>& value);
+
+#if !defined(FIXED_NO_FLOATING_POINT)
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator-(double a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp-=b;
+}
+
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator-(float a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp-=b;
+}
+#endif
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator-(unsigned long a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp-=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator-(long a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp-=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator-(unsigned a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp-=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator-(int a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp-=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator-(unsigned short a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp-=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator-(short a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp-=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator-(unsigned char a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp-=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator-(char a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp-=b;
+}
+
+#if !defined(FIXED_NO_FLOATING_POINT)
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator-(basic_fixed<StorageInt,FracBits> const& a,double b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp-=b;
+}
+
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator-(basic_fixed<StorageInt,FracBits> const& a,float b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp-=b;
+}
+#endif
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator-(basic_fixed<StorageInt,FracBits> const& a,unsigned long b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp-=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator-(basic_fixed<StorageInt,FracBits> const& a,long b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp-=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator-(basic_fixed<StorageInt,FracBits> const& a,unsigned b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp-=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator-(basic_fixed<StorageInt,FracBits> const& a,int b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp-=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator-(basic_fixed<StorageInt,FracBits> const& a,unsigned short b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp-=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator-(basic_fixed<StorageInt,FracBits> const& a,short b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp-=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator-(basic_fixed<StorageInt,FracBits> const& a,unsigned char b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp-=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator-(basic_fixed<StorageInt,FracBits> const& a,char b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp-=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator-(basic_fixed<StorageInt,FracBits> const& a,basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp-=b;
+}
+
+#if !defined(FIXED_NO_FLOATING_POINT)
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator%(double a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp%=b;
+}
+
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator%(float a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp%=b;
+}
+#endif
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator%(unsigned long a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp%=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator%(long a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp%=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator%(unsigned a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp%=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator%(int a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp%=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator%(unsigned short a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp%=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator%(short a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp%=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator%(unsigned char a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp%=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator%(char a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp%=b;
+}
+
+#if !defined(FIXED_NO_FLOATING_POINT)
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator%(basic_fixed<StorageInt,FracBits> const& a,double b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp%=b;
+}
+
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator%(basic_fixed<StorageInt,FracBits> const& a,float b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp%=b;
+}
+#endif
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator%(basic_fixed<StorageInt,FracBits> const& a,unsigned long b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp%=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator%(basic_fixed<StorageInt,FracBits> const& a,long b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp%=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator%(basic_fixed<StorageInt,FracBits> const& a,unsigned b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp%=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator%(basic_fixed<StorageInt,FracBits> const& a,int b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp%=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator%(basic_fixed<StorageInt,FracBits> const& a,unsigned short b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp%=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator%(basic_fixed<StorageInt,FracBits> const& a,short b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp%=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator%(basic_fixed<StorageInt,FracBits> const& a,unsigned char b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp%=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator%(basic_fixed<StorageInt,FracBits> const& a,char b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp%=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator%(basic_fixed<StorageInt,FracBits> const& a,basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp%=b;
+}
+
+#if !defined(FIXED_NO_FLOATING_POINT)
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator+(double a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp+=b;
+}
+
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator+(float a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp+=b;
+}
+#endif
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator+(unsigned long a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp+=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator+(long a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp+=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator+(unsigned a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp+=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator+(int a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp+=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator+(unsigned short a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp+=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator+(short a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp+=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator+(unsigned char a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp+=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator+(char a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp+=b;
+}
+
+#if !defined(FIXED_NO_FLOATING_POINT)
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator+(basic_fixed<StorageInt,FracBits> const& a,double b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp+=b;
+}
+
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator+(basic_fixed<StorageInt,FracBits> const& a,float b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp+=b;
+}
+#endif
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator+(basic_fixed<StorageInt,FracBits> const& a,unsigned long b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp+=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator+(basic_fixed<StorageInt,FracBits> const& a,long b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp+=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator+(basic_fixed<StorageInt,FracBits> const& a,unsigned b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp+=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator+(basic_fixed<StorageInt,FracBits> const& a,int b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp+=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator+(basic_fixed<StorageInt,FracBits> const& a,unsigned short b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp+=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator+(basic_fixed<StorageInt,FracBits> const& a,short b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp+=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator+(basic_fixed<StorageInt,FracBits> const& a,unsigned char b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp+=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator+(basic_fixed<StorageInt,FracBits> const& a,char b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp+=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator+(basic_fixed<StorageInt,FracBits> const& a,basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp+=b;
+}
+
+#if !defined(FIXED_NO_FLOATING_POINT)
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator*(double a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(b);
+    return temp*=a;
+}
+
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator*(float a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(b);
+    return temp*=a;
+}
+#endif
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator*(unsigned long a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(b);
+    return temp*=a;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator*(long a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(b);
+    return temp*=a;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator*(unsigned a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(b);
+    return temp*=a;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator*(int a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(b);
+    return temp*=a;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator*(unsigned short a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(b);
+    return temp*=a;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator*(short a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(b);
+    return temp*=a;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator*(unsigned char a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(b);
+    return temp*=a;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator*(char a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(b);
+    return temp*=a;
+}
+
+#if !defined(FIXED_NO_FLOATING_POINT)
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator*(basic_fixed<StorageInt,FracBits> const& a,double b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp*=b;
+}
+
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator*(basic_fixed<StorageInt,FracBits> const& a,float b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp*=b;
+}
+#endif
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator*(basic_fixed<StorageInt,FracBits> const& a,unsigned long b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp*=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator*(basic_fixed<StorageInt,FracBits> const& a,long b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp*=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator*(basic_fixed<StorageInt,FracBits> const& a,unsigned b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp*=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator*(basic_fixed<StorageInt,FracBits> const& a,int b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp*=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator*(basic_fixed<StorageInt,FracBits> const& a,unsigned short b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp*=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator*(basic_fixed<StorageInt,FracBits> const& a,short b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp*=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator*(basic_fixed<StorageInt,FracBits> const& a,unsigned char b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp*=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator*(basic_fixed<StorageInt,FracBits> const& a,char b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp*=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator*(basic_fixed<StorageInt,FracBits> const& a,basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp*=b;
+}
+
+#if !defined(FIXED_NO_FLOATING_POINT)
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator/(double a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp/=b;
+}
+
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator/(float a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp/=b;
+}
+#endif
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator/(unsigned long a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp/=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator/(long a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp/=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator/(unsigned a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp/=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator/(int a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp/=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator/(unsigned short a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp/=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator/(short a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp/=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator/(unsigned char a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp/=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator/(char a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp/=b;
+}
+
+#if !defined(FIXED_NO_FLOATING_POINT)
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator/(basic_fixed<StorageInt,FracBits> const& a,double b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp/=b;
+}
+
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator/(basic_fixed<StorageInt,FracBits> const& a,float b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp/=b;
+}
+#endif
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator/(basic_fixed<StorageInt,FracBits> const& a,unsigned long b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp/=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator/(basic_fixed<StorageInt,FracBits> const& a,long b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp/=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator/(basic_fixed<StorageInt,FracBits> const& a,unsigned b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp/=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator/(basic_fixed<StorageInt,FracBits> const& a,int b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp/=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator/(basic_fixed<StorageInt,FracBits> const& a,unsigned short b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp/=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator/(basic_fixed<StorageInt,FracBits> const& a,short b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp/=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator/(basic_fixed<StorageInt,FracBits> const& a,unsigned char b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp/=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator/(basic_fixed<StorageInt,FracBits> const& a,char b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp/=b;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> operator/(basic_fixed<StorageInt,FracBits> const& a,basic_fixed<StorageInt,FracBits> const& b)
+{
+    basic_fixed<StorageInt,FracBits> temp(a);
+    return temp/=b;
+}
+
+#if !defined(FIXED_NO_FLOATING_POINT)
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator==(double a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)==b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator==(float a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)==b;
+}
+#endif
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator==(unsigned long a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)==b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator==(long a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)==b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator==(unsigned a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)==b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator==(int a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)==b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator==(unsigned short a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)==b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator==(short a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)==b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator==(unsigned char a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)==b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator==(char a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)==b;
+}
+
+#if !defined(FIXED_NO_FLOATING_POINT)
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator==(basic_fixed<StorageInt,FracBits> const& a,double b)
+{
+    return a==basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator==(basic_fixed<StorageInt,FracBits> const& a,float b)
+{
+    return a==basic_fixed<StorageInt,FracBits>(b);
+}
+#endif
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator==(basic_fixed<StorageInt,FracBits> const& a,unsigned long b)
+{
+    return a==basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator==(basic_fixed<StorageInt,FracBits> const& a,long b)
+{
+    return a==basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator==(basic_fixed<StorageInt,FracBits> const& a,unsigned b)
+{
+    return a==basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator==(basic_fixed<StorageInt,FracBits> const& a,int b)
+{
+    return a==basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator==(basic_fixed<StorageInt,FracBits> const& a,unsigned short b)
+{
+    return a==basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator==(basic_fixed<StorageInt,FracBits> const& a,short b)
+{
+    return a==basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator==(basic_fixed<StorageInt,FracBits> const& a,unsigned char b)
+{
+    return a==basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator==(basic_fixed<StorageInt,FracBits> const& a,char b)
+{
+    return a==basic_fixed<StorageInt,FracBits>(b);
+}
+
+#if !defined(FIXED_NO_FLOATING_POINT)
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator!=(double a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)!=b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator!=(float a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)!=b;
+}
+#endif
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator!=(unsigned long a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)!=b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator!=(long a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)!=b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator!=(unsigned a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)!=b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator!=(int a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)!=b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator!=(unsigned short a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)!=b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator!=(short a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)!=b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator!=(unsigned char a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)!=b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator!=(char a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)!=b;
+}
+
+#if !defined(FIXED_NO_FLOATING_POINT)
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator!=(basic_fixed<StorageInt,FracBits> const& a,double b)
+{
+    return a!=basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator!=(basic_fixed<StorageInt,FracBits> const& a,float b)
+{
+    return a!=basic_fixed<StorageInt,FracBits>(b);
+}
+#endif
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator!=(basic_fixed<StorageInt,FracBits> const& a,unsigned long b)
+{
+    return a!=basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator!=(basic_fixed<StorageInt,FracBits> const& a,long b)
+{
+    return a!=basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator!=(basic_fixed<StorageInt,FracBits> const& a,unsigned b)
+{
+    return a!=basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator!=(basic_fixed<StorageInt,FracBits> const& a,int b)
+{
+    return a!=basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator!=(basic_fixed<StorageInt,FracBits> const& a,unsigned short b)
+{
+    return a!=basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator!=(basic_fixed<StorageInt,FracBits> const& a,short b)
+{
+    return a!=basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator!=(basic_fixed<StorageInt,FracBits> const& a,unsigned char b)
+{
+    return a!=basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator!=(basic_fixed<StorageInt,FracBits> const& a,char b)
+{
+    return a!=basic_fixed<StorageInt,FracBits>(b);
+}
+
+#if !defined(FIXED_NO_FLOATING_POINT)
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<(double a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)<b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<(float a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)<b;
+}
+#endif
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<(unsigned long a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)<b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<(long a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)<b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<(unsigned a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)<b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<(int a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)<b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<(unsigned short a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)<b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<(short a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)<b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<(unsigned char a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)<b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<(char a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)<b;
+}
+
+#if !defined(FIXED_NO_FLOATING_POINT)
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<(basic_fixed<StorageInt,FracBits> const& a,double b)
+{
+    return a<basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<(basic_fixed<StorageInt,FracBits> const& a,float b)
+{
+    return a<basic_fixed<StorageInt,FracBits>(b);
+}
+#endif
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<(basic_fixed<StorageInt,FracBits> const& a,unsigned long b)
+{
+    return a<basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<(basic_fixed<StorageInt,FracBits> const& a,long b)
+{
+    return a<basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<(basic_fixed<StorageInt,FracBits> const& a,unsigned b)
+{
+    return a<basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<(basic_fixed<StorageInt,FracBits> const& a,int b)
+{
+    return a<basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<(basic_fixed<StorageInt,FracBits> const& a,unsigned short b)
+{
+    return a<basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<(basic_fixed<StorageInt,FracBits> const& a,short b)
+{
+    return a<basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<(basic_fixed<StorageInt,FracBits> const& a,unsigned char b)
+{
+    return a<basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<(basic_fixed<StorageInt,FracBits> const& a,char b)
+{
+    return a<basic_fixed<StorageInt,FracBits>(b);
+}
+
+#if !defined(FIXED_NO_FLOATING_POINT)
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>(double a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)>b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>(float a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)>b;
+}
+#endif
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>(unsigned long a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)>b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>(long a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)>b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>(unsigned a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)>b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>(int a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)>b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>(unsigned short a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)>b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>(short a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)>b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>(unsigned char a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)>b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>(char a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)>b;
+}
+
+#if !defined(FIXED_NO_FLOATING_POINT)
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>(basic_fixed<StorageInt,FracBits> const& a,double b)
+{
+    return a>basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>(basic_fixed<StorageInt,FracBits> const& a,float b)
+{
+    return a>basic_fixed<StorageInt,FracBits>(b);
+}
+#endif
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>(basic_fixed<StorageInt,FracBits> const& a,unsigned long b)
+{
+    return a>basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>(basic_fixed<StorageInt,FracBits> const& a,long b)
+{
+    return a>basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>(basic_fixed<StorageInt,FracBits> const& a,unsigned b)
+{
+    return a>basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>(basic_fixed<StorageInt,FracBits> const& a,int b)
+{
+    return a>basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>(basic_fixed<StorageInt,FracBits> const& a,unsigned short b)
+{
+    return a>basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>(basic_fixed<StorageInt,FracBits> const& a,short b)
+{
+    return a>basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>(basic_fixed<StorageInt,FracBits> const& a,unsigned char b)
+{
+    return a>basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>(basic_fixed<StorageInt,FracBits> const& a,char b)
+{
+    return a>basic_fixed<StorageInt,FracBits>(b);
+}
+
+#if !defined(FIXED_NO_FLOATING_POINT)
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<=(double a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)<=b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<=(float a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)<=b;
+}
+#endif
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<=(unsigned long a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)<=b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<=(long a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)<=b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<=(unsigned a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)<=b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<=(int a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)<=b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<=(unsigned short a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)<=b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<=(short a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)<=b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<=(unsigned char a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)<=b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<=(char a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)<=b;
+}
+
+#if !defined(FIXED_NO_FLOATING_POINT)
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<=(basic_fixed<StorageInt,FracBits> const& a,double b)
+{
+    return a<=basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<=(basic_fixed<StorageInt,FracBits> const& a,float b)
+{
+    return a<=basic_fixed<StorageInt,FracBits>(b);
+}
+#endif
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<=(basic_fixed<StorageInt,FracBits> const& a,unsigned long b)
+{
+    return a<=basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<=(basic_fixed<StorageInt,FracBits> const& a,long b)
+{
+    return a<=basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<=(basic_fixed<StorageInt,FracBits> const& a,unsigned b)
+{
+    return a<=basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<=(basic_fixed<StorageInt,FracBits> const& a,int b)
+{
+    return a<=basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<=(basic_fixed<StorageInt,FracBits> const& a,unsigned short b)
+{
+    return a<=basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<=(basic_fixed<StorageInt,FracBits> const& a,short b)
+{
+    return a<=basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<=(basic_fixed<StorageInt,FracBits> const& a,unsigned char b)
+{
+    return a<=basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator<=(basic_fixed<StorageInt,FracBits> const& a,char b)
+{
+    return a<=basic_fixed<StorageInt,FracBits>(b);
+}
+
+#if !defined(FIXED_NO_FLOATING_POINT)
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>=(double a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)>=b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>=(float a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)>=b;
+}
+#endif
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>=(unsigned long a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)>=b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>=(long a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)>=b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>=(unsigned a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)>=b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>=(int a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)>=b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>=(unsigned short a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)>=b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>=(short a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)>=b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>=(unsigned char a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)>=b;
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>=(char a, basic_fixed<StorageInt,FracBits> const& b)
+{
+    return basic_fixed<StorageInt,FracBits>(a)>=b;
+}
+
+#if !defined(FIXED_NO_FLOATING_POINT)
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>=(basic_fixed<StorageInt,FracBits> const& a,double b)
+{
+    return a>=basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>=(basic_fixed<StorageInt,FracBits> const& a,float b)
+{
+    return a>=basic_fixed<StorageInt,FracBits>(b);
+}
+#endif
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>=(basic_fixed<StorageInt,FracBits> const& a,unsigned long b)
+{
+    return a>=basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>=(basic_fixed<StorageInt,FracBits> const& a,long b)
+{
+    return a>=basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>=(basic_fixed<StorageInt,FracBits> const& a,unsigned b)
+{
+    return a>=basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>=(basic_fixed<StorageInt,FracBits> const& a,int b)
+{
+    return a>=basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>=(basic_fixed<StorageInt,FracBits> const& a,unsigned short b)
+{
+    return a>=basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>=(basic_fixed<StorageInt,FracBits> const& a,short b)
+{
+    return a>=basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>=(basic_fixed<StorageInt,FracBits> const& a,unsigned char b)
+{
+    return a>=basic_fixed<StorageInt,FracBits>(b);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR bool operator>=(basic_fixed<StorageInt,FracBits> const& a,char b)
+{
+    return a>=basic_fixed<StorageInt,FracBits>(b);
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR_MATH basic_fixed<StorageInt,FracBits> sin(basic_fixed<StorageInt,FracBits> const& x)
+{
+    return x.sin();
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR_MATH basic_fixed<StorageInt,FracBits> cos(basic_fixed<StorageInt,FracBits> const& x)
+{
+    return x.cos();
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR_MATH basic_fixed<StorageInt,FracBits> tan(basic_fixed<StorageInt,FracBits> const& x)
+{
+    return x.tan();
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR_MATH basic_fixed<StorageInt,FracBits> sqrt(basic_fixed<StorageInt,FracBits> const& x)
+{
+    return x.sqrt();
+}
+
+// sqrt(x^2+y^2) and sqrt(x^2+y^2+z^2), correctly rounded. The squares are
+// summed exactly in 128 bits, so nothing overflows until the result itself
+// does, and then it saturates.
+template<typename StorageInt,unsigned FracBits>
+inline basic_fixed<StorageInt,FracBits> hypot(basic_fixed<StorageInt,FracBits> const& x,basic_fixed<StorageInt,FracBits> const& y)
+{
+    return basic_fixed<StorageInt,FracBits>::hypot(x,y);
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline basic_fixed<StorageInt,FracBits> hypot(basic_fixed<StorageInt,FracBits> const& x,basic_fixed<StorageInt,FracBits> const& y,basic_fixed<StorageInt,FracBits> const& z)
+{
+    return basic_fixed<StorageInt,FracBits>::hypot(x,y,z);
+}
+
+// 1/x from a table seed and a fixed number of Newton steps, so the cost
+// does not depend on x. The result is within one ulp of the exact value.
+// Division by zero gives the maximum value, as with operator/.
+template<typename StorageInt,unsigned FracBits>
+inline basic_fixed<StorageInt,FracBits> reciprocal(basic_fixed<StorageInt,FracBits> const& x)
+{
+    return x.reciprocal();
+}
+
+// 1/sqrt(x) in the same way as reciprocal(), also within one ulp. Zero
+// and negative inputs give the maximum value.
+template<typename StorageInt,unsigned FracBits>
+inline basic_fixed<StorageInt,FracBits> rsqrt(basic_fixed<StorageInt,FracBits> const& x)
+{
+    return x.rsqrt();
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR_MATH basic_fixed<StorageInt,FracBits> exp(basic_fixed<StorageInt,FracBits> const& x)
+{
+    return x.exp();
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR_MATH basic_fixed<StorageInt,FracBits> log(basic_fixed<StorageInt,FracBits> const& x)
+{
+    return x.log();
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline basic_fixed<StorageInt,FracBits> atan(basic_fixed<StorageInt,FracBits> const& x)
+{
+    return x.atan();
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline basic_fixed<StorageInt,FracBits> atan2(basic_fixed<StorageInt,FracBits> const& y,basic_fixed<StorageInt,FracBits> const& x)
+{
+    return basic_fixed<StorageInt,FracBits>::atan2(y,x);
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline basic_fixed<StorageInt,FracBits> asin(basic_fixed<StorageInt,FracBits> const& x)
+{
+    return x.asin();
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline basic_fixed<StorageInt,FracBits> acos(basic_fixed<StorageInt,FracBits> const& x)
+{
+    return x.acos();
+}
+
+// atan2(y,x) in degrees, in [-180,180), from the same kernel as atan2()
+template<typename StorageInt,unsigned FracBits>
+inline basic_fixed<StorageInt,FracBits> atan2_deg(basic_fixed<StorageInt,FracBits> const& y,basic_fixed<StorageInt,FracBits> const& x)
+{
+    return basic_fixed<StorageInt,FracBits>::atan2_deg(y,x);
+}
+
+// 2^x and log2(x) share the exp()/log() kernels but skip the conversion
+// through ln(2), so 2^n and log2(2^n) are exact. log2() of zero or a
+// negative value gives minus the maximum value.
+template<typename StorageInt,unsigned FracBits>
+inline basic_fixed<StorageInt,FracBits> exp2(basic_fixed<StorageInt,FracBits> const& x)
+{
+    return x.exp2();
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline basic_fixed<StorageInt,FracBits> log2(basic_fixed<StorageInt,FracBits> const& x)
+{
+    return x.log2();
+}
+
+// x^y as 2^(y*log2(x)) with the product kept at full width, so a large y
+// does not magnify the rounding of log2(x). A negative x is only allowed
+// for an integral y; otherwise the result is zero. Overflow saturates.
+template<typename StorageInt,unsigned FracBits>
+inline basic_fixed<StorageInt,FracBits> pow(basic_fixed<StorageInt,FracBits> const& x,basic_fixed<StorageInt,FracBits> const& y)
+{
+    return x.pow(y);
+}
+
+// x^n for an integer n by repeated squaring of x, or of 1/x for a negative
+// n, in a 128-bit mantissa with its own exponent, so the powers neither
+// overflow nor lose bits on the way. The result is rounded to nearest;
+// overflow saturates as in pow().
+template<typename StorageInt,unsigned FracBits>
+inline basic_fixed<StorageInt,FracBits> pown(basic_fixed<StorageInt,FracBits> const& x,int n)
+{
+    return x.pown(n);
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> floor(basic_fixed<StorageInt,FracBits> const& x)
+{
+    return x.floor();
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> ceil(basic_fixed<StorageInt,FracBits> const& x)
+{
+    return x.ceil();
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR basic_fixed<StorageInt,FracBits> abs(basic_fixed<StorageInt,FracBits> const& x)
+{
+    return x.abs();
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> modf(basic_fixed<StorageInt,FracBits> const& x,basic_fixed<StorageInt,FracBits>* integral_part)
+{
+    return x.modf(integral_part);
+}
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> basic_fixed<StorageInt,FracBits>::ceil() const
+{
+    if(m_nVal%resolution)
+    {
+        return floor()+1;
+    }
+    else
+    {
+        return *this;
+    }
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> basic_fixed<StorageInt,FracBits>::floor() const
+{
+    basic_fixed res(*this);
+    StorageInt const remainder=m_nVal%resolution;
+    if(remainder)
+    {
+        res.m_nVal-=remainder;
+        if(m_nVal<0)
+        {
+            res-=1;
+        }
+    }
+    return res;
+}
+
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR_MATH basic_fixed<StorageInt,FracBits> basic_fixed<StorageInt,FracBits>::sin() const
+{
+    basic_fixed res;
+    sin_cos(*this,&res,0);
+    return res;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR_MATH basic_fixed<StorageInt,FracBits> basic_fixed<StorageInt,FracBits>::cos() const
+{
+    basic_fixed res;
+    sin_cos(*this,0,&res);
+    return res;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR_MATH basic_fixed<StorageInt,FracBits> basic_fixed<StorageInt,FracBits>::tan() const
+{
+    basic_fixed s,c;
+    sin_cos(*this,&s,&c);
+    return s/c;
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR basic_fixed<StorageInt,FracBits> basic_fixed<StorageInt,FracBits>::operator-() const
+{
+    return basic_fixed(internal(),-m_nVal);
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR basic_fixed<StorageInt,FracBits> basic_fixed<StorageInt,FracBits>::abs() const
+{
+    return basic_fixed(internal(),m_nVal<0?-m_nVal:m_nVal);
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> basic_fixed<StorageInt,FracBits>::modf(basic_fixed*integral_part) const
+{
+    StorageInt fractional_part=m_nVal%resolution;
+    if(m_nVal<0 && fractional_part>0)
+    {
+        fractional_part-=resolution;
+    }
+    integral_part->m_nVal=m_nVal-fractional_part;
+    return basic_fixed(internal(),fractional_part);
+}
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR14 basic_fixed<StorageInt,FracBits> basic_fixed<StorageInt,FracBits>::from_wide(__int64 val,unsigned frac_bits)
+{
+    int const shift=int(frac_bits)-int(FracBits);
+    if(shift>0)
+    {
+        val=(val>>shift)+((val>>(shift-1))&1);
+    }
+    return basic_fixed(internal(),StorageInt((unsigned __int64)val<<((shift<0)?-shift:0)));
+}
+
+template<typename StorageInt,unsigned FracBits>
+template<unsigned Count>
+inline FIXED_CONSTEXPR_ARITHMETIC basic_fixed<StorageInt,FracBits> basic_fixed<StorageInt,FracBits>::horner(fixed_coefficient const (&coefficients)[Count],basic_fixed const& x)
+{
+    return from_wide(fixed_polynomial<Count>::horner(coefficients,x.m_nVal,FracBits),coefficients[0].frac_bits);
+}
+
+template<typename StorageInt,unsigned FracBits>
+template<unsigned Count>
+inline FIXED_CONSTEXPR_ARITHMETIC basic_fixed<StorageInt,FracBits> basic_fixed<StorageInt,FracBits>::estrin(fixed_coefficient const (&coefficients)[Count],basic_fixed const& x)
+{
+    // the square of any 32-bit value fits in 64 bits
+    unsigned const power_bits=FracBits*((fixed_storage_traits<StorageInt>::bits<=32)?2:1);
+    __int64 powers[fixed_polynomial<Count>::levels]={x.m_nVal};
+    for(unsigned k=1;k<fixed_polynomial<Count>::levels;++k)
+    {
+        unsigned const previous_bits=(k==1)?FracBits:power_bits;
+        powers[k]=fixed_multiply_shift(powers[k-1],powers[k-1],int(2*previous_bits)-int(power_bits));
+    }
+    return from_wide(fixed_polynomial<Count>::estrin(coefficients,powers,FracBits,power_bits),coefficients[0].frac_bits);
+}
+
+namespace std
+{
+    template<typename StorageInt,unsigned FracBits>
+    inline ::basic_fixed<StorageInt,FracBits> arg(const std::complex< ::basic_fixed<StorageInt,FracBits> >& val)
+    {
+        ::basic_fixed<StorageInt,FracBits> r,theta;
+        ::basic_fixed<StorageInt,FracBits>::to_polar(val.real(),val.imag(),&r,&theta);
+        return theta;
+    }
+
+    template<typename StorageInt,unsigned FracBits>
+    inline complex< ::basic_fixed<StorageInt,FracBits> > polar(::basic_fixed<StorageInt,FracBits> const& rho,::basic_fixed<StorageInt,FracBits> const& theta)
+    {
+        ::basic_fixed<StorageInt,FracBits> s,c;
+        ::basic_fixed<StorageInt,FracBits>::sin_cos(theta,&s,&c);
+        return complex< ::basic_fixed<StorageInt,FracBits> >(rho * c, rho * s);
+    }
+}
+
+// Q35.28 in 64 bits: the original format, for when range matters
+typedef basic_fixed<__int64,fixed_resolution_shift> fixed;
+// Q15.16 in 32 bits: half the size and cheaper arithmetic
+typedef basic_fixed<int,16> fixed32;
+
+// An angle held as an unsigned binary fraction of a turn (binary angle
+// measurement), so sums and differences wrap at a full turn through plain
+// integer overflow. basic_fixed::sin_cos() and to_polar() take one
+// directly and skip range reduction altogether.
+template<typename UnsignedInt>
+class basic_fixed_angle
+{
+private:
+    UnsignedInt m_nVal;
+
+    static unsigned const turn_shift=64-sizeof(UnsignedInt)*8;
+
+public:
+    typedef UnsignedInt storage_type;
+
+    struct internal
+    {};
+
+    FIXED_CONSTEXPR basic_fixed_angle():
+        m_nVal(0)
+    {}
+
+    FIXED_CONSTEXPR basic_fixed_angle(internal, UnsignedInt nVal):
+        m_nVal(nVal)
+    {}
+
+    // From radians. Converting back with as_radians() gives the same value
+    // for angles in [-pi,pi) whenever the angle has at least as many bits
+    // as the radians have below the binary point plus four.
+    template<typename StorageInt,unsigned FracBits>
+    explicit basic_fixed_angle(basic_fixed<StorageInt,FracBits> const& radians):
+        m_nVal(from_turns(radians.as_turns()).m_nVal)
+    {}
+
+    // Q64 fraction of a turn, rounded to the nearest angle
+    static FIXED_CONSTEXPR14 basic_fixed_angle from_turns(unsigned __int64 turns)
+    {
+        unsigned __int64 const half=((unsigned __int64)1<<turn_shift)>>1;
+        return basic_fixed_angle(internal(),UnsignedInt((turns+half)>>turn_shift));
+    }
+
+    FIXED_CONSTEXPR unsigned __int64 as_turns() const
+    {
+        return (unsigned __int64)m_nVal<<turn_shift;
+    }
+
+    // radians in [-pi,pi)
+    template<typename Fixed>
+    Fixed as_radians() const
+    {
+        return Fixed::from_turns(as_turns());
+    }
+
+    FIXED_CONSTEXPR14 basic_fixed_angle& operator+=(basic_fixed_angle const& other)
+    {
+        m_nVal+=other.m_nVal;
+        return *this;
+    }
+    FIXED_CONSTEXPR14 basic_fixed_angle& operator-=(basic_fixed_angle const& other)
+    {
+        m_nVal-=other.m_nVal;
+        return *this;
+    }
+    FIXED_CONSTEXPR basic_fixed_angle operator-() const
+    {
+        return basic_fixed_angle(internal(),UnsignedInt(0-m_nVal));
+    }
+
+    friend FIXED_CONSTEXPR14 basic_fixed_angle operator+(basic_fixed_angle lhs,basic_fixed_angle const& rhs)
+    {
+        return lhs+=rhs;
+    }
+    friend FIXED_CONSTEXPR14 basic_fixed_angle operator-(basic_fixed_angle lhs,basic_fixed_angle const& rhs)
+    {
+        return lhs-=rhs;
+    }
+    friend FIXED_CONSTEXPR bool operator==(basic_fixed_angle const& lhs,basic_fixed_angle const& rhs)
+    {
+        return lhs.m_nVal==rhs.m_nVal;
+    }
+    friend FIXED_CONSTEXPR bool operator!=(basic_fixed_angle const& lhs,basic_fixed_angle const& rhs)
+    {
+        return lhs.m_nVal!=rhs.m_nVal;
+    }
+};
+
+// 2^-64 and 2^-32 of a turn
+typedef basic_fixed_angle<unsigned __int64> fixed_angle;
+typedef basic_fixed_angle<unsigned int> fixed_angle32;
+
+// Interpolation policies for fixed_lut. interpolate() gets y pointing at
+// the sample at the start of the interval and t in [0,1] across it, and
+// may read samples_before entries below and samples_after above.
+
+// Straight line between the two samples bounding the interval
+struct fixed_lut_linear
+{
+    static unsigned const samples_before=0;
+    static unsigned const samples_after=1;
+
+    template<typename Fixed>
+    static FIXED_CONSTEXPR_ARITHMETIC Fixed interpolate(Fixed const* y,Fixed const& t)
+    {
+        return y[0]+(y[1]-y[0])*t;
+    }
+};
+
+// Catmull-Rom cubic through the four nearest samples: continuous slope
+// across intervals and exact for quadratics, for three more multiplies
+struct fixed_lut_cubic
+{
+    static unsigned const samples_before=1;
+    static unsigned const samples_after=2;
+
+    template<typename Fixed>
+    static FIXED_CONSTEXPR_ARITHMETIC Fixed interpolate(Fixed const* y,Fixed const& t)
+    {
+        Fixed const c1=y[1]-y[-1];
+        Fixed const c2=y[-1]*2-y[0]*5+y[1]*4-y[2];
+        Fixed const c3=(y[0]-y[1])*3+y[2]-y[-1];
+        return y[0]+(((c3*t+c2)*t+c1)*t)/2;
+    }
+};
+
+// A table of N intervals approximating Function over [lower,upper].
+// Function is a default-constructible function object with a value_type
+// typedef naming the basic_fixed format and a const operator() taking and
+// returning one. The interval width is the smallest power of two of the
+// format's resolution that covers the range, so a lookup is a subtract, a
+// shift and a mask: no search and no divide. Inputs outside the range are
+// clamped to it, which must span less than half the format's range.
+//
+// Samples are taken on that grid from lower, so Function is evaluated up
+// to samples_after intervals past the last one that holds upper and, for
+// the cubic, one interval below lower; choose upper-lower as N times a
+// power of two for the grid to end exactly on upper. The constructor is
+// constexpr when Function's operator() is, so such a table can be built
+// at compile time; otherwise a namespace-scope table is built once at load.
+template<typename Function,unsigned N,typename Interp=fixed_lut_linear>
+class fixed_lut
+{
+public:
+    typedef typename Function::value_type value_type;
+
+private:
+    typedef typename value_type::storage_type storage_type;
+    typedef typename value_type::unsigned_storage_type unsigned_storage_type;
+
+    static unsigned const sample_count=N+Interp::samples_before+Interp::samples_after;
+
+    storage_type m_lower;
+    unsigned_storage_type m_width;
+    unsigned m_shift;
+    value_type m_samples[sample_count];
+
+    FIXED_CONSTEXPR_ARITHMETIC value_type interpolate(unsigned_storage_type offset) const
+    {
+        unsigned index=unsigned(offset>>m_shift);
+        // only upper itself can land past the last interval
+        if(index==N)
+        {
+            --index;
+        }
+        unsigned_storage_type const fraction=offset-((unsigned_storage_type)index<<m_shift);
+        unsigned const frac_bits=value_type::resolution_shift;
+        value_type const t(typename value_type::internal(),storage_type(
+            (m_shift<=frac_bits)?(fraction<<(frac_bits-m_shift)):(fraction>>(m_shift-frac_bits))));
+        return Interp::interpolate(m_samples+Interp::samples_before+index,t);
+    }
+
+public:
+    FIXED_CONSTEXPR14 fixed_lut(value_type const& lower,value_type const& upper):
+        m_lower(lower.m_nVal),
+        m_width(unsigned_storage_type(upper.m_nVal)-unsigned_storage_type(lower.m_nVal)),
+        m_shift(0),
+        m_samples()
+    {
+        while(((unsigned_storage_type)N<<m_shift)<m_width)
+        {
+            ++m_shift;
+        }
+        Function const function=Function();
+        for(unsigned i=0;i<sample_count;++i)
+        {
+            unsigned_storage_type const step=(unsigned_storage_type)1<<m_shift;
+            unsigned_storage_type const x=unsigned_storage_type(m_lower)+i*step-Interp::samples_before*step;
+            m_samples[i]=function(value_type(typename value_type::internal(),storage_type(x)));
+        }
+    }
+
+    FIXED_CONSTEXPR_ARITHMETIC value_type operator()(value_type const& x) const
+    {
+        unsigned_storage_type offset=0;
+        if(x.m_nVal>m_lower)
+        {
+            offset=unsigned_storage_type(x.m_nVal)-unsigned_storage_type(m_lower);
+            if(offset>m_width)
+            {
+                offset=m_width;
+            }
+        }
+        return interpolate(offset);
+    }
+
+    FIXED_CONSTEXPR value_type lower() const
+    {
+        return value_type(typename value_type::internal(),m_lower);
+    }
+    FIXED_CONSTEXPR value_type upper() const
+    {
+        return value_type(typename value_type::internal(),storage_type(unsigned_storage_type(m_lower)+m_width));
+    }
+    // width of each interval
+    FIXED_CONSTEXPR value_type step() const
+    {
+        return value_type(typename value_type::internal(),storage_type((unsigned_storage_type)1<<m_shift));
+    }
+
+    // Largest absolute difference from Function over [lower,upper], checked
+    // at samples_per_interval evenly spaced points in each interval and at
+    // upper; *where receives the input at which it occurs.
+    FIXED_CONSTEXPR_ARITHMETIC value_type max_error(unsigned samples_per_interval=16,value_type* where=0) const
+    {
+        Function const function=Function();
+        unsigned_storage_type stride=((unsigned_storage_type)1<<m_shift)/(samples_per_interval?samples_per_interval:1);
+        if(!stride)
+        {
+            stride=1;
+        }
+        value_type worst;
+        value_type worst_x=lower();
+        unsigned_storage_type offset=0;
+        for(;;)
+        {
+            value_type const x(typename value_type::internal(),storage_type(unsigned_storage_type(m_lower)+offset));
+            value_type const error=(interpolate(offset)-function(x)).abs();
+            if(error>worst)
+            {
+                worst=error;
+                worst_x=x;
+            }
+            if(offset==m_width)
+            {
+                break;
+            }
+            offset=(m_width-offset<stride)?m_width:offset+stride;
+        }
+        if(where)
+        {
+            *where=worst_x;
+        }
+        return worst;
+    }
+};
+
+// A sum of basic_fixed values and products held exactly in 128 bits with
+// twice the fractional bits, rounded to nearest only when result() is read.
+// A long sum of products then has one rounding error rather than one per
+// term. For fixed a single full-range product already takes 127 bits, so
+// the sum also counts how often it has wrapped around 128 bits; it stays
+// exact through 2^63 such wraps, and result() saturates if the final sum
+// does not fit the format.
+template<typename StorageInt,unsigned FracBits>
+class basic_fixed_accumulator
+{
+public:
+    typedef basic_fixed<StorageInt,FracBits> value_type;
+
+private:
+    // the sum is m_wraps*2^128 plus m_upper:m_lower read as signed
+    unsigned __int64 m_lower;
+    __int64 m_upper;
+    __int64 m_wraps;
+
+    // a signed overflow of the upper word counts one wrap in the direction
+    // of the operand, without a branch
+    FIXED_CONSTEXPR14 void add(__int64 upper,unsigned __int64 lower)
+    {
+        __int64 const old_upper=m_upper;
+        m_lower+=lower;
+        m_upper=(__int64)((unsigned __int64)m_upper+((unsigned __int64)upper+((m_lower<lower)?1:0)));
+        m_wraps+=((old_upper^m_upper)&(upper^m_upper))>>63&((upper>>63)|1);
+    }
+
+    FIXED_CONSTEXPR14 void subtract(__int64 upper,unsigned __int64 lower)
+    {
+        __int64 const old_upper=m_upper;
+        m_upper=(__int64)((unsigned __int64)m_upper-(unsigned __int64)upper-((m_lower<lower)?1:0));
+        m_lower-=lower;
+        m_wraps-=((old_upper^upper)&(old_upper^m_upper))>>63&((upper>>63)|1);
+    }
+
+    // the exact product, in 64 bits for 32-bit formats
+    static FIXED_CONSTEXPR_ARITHMETIC __int64 product(value_type const& a,value_type const& b,unsigned __int64* lower)
+    {
+        if(fixed_storage_traits<StorageInt>::bits<=32)
+        {
+            __int64 const res=(__int64)a.m_nVal*b.m_nVal;
+            *lower=(unsigned __int64)res;
+            return res>>63;
+        }
+        return fixed_multiply_wide(a.m_nVal,b.m_nVal,lower);
+    }
+
+    // adds a*b without looking for a wrap, adding the top 32 bits of the
+    // product to top instead
+    static FIXED_CONSTEXPR_ARITHMETIC void add_product_unchecked(value_type const& a,value_type const& b,unsigned __int64& sum_lower,unsigned __int64& sum_upper,__int64& top)
+    {
+        unsigned __int64 lower=0;
+        __int64 const upper=product(a,b,&lower);
+        sum_lower+=lower;
+        sum_upper+=(unsigned __int64)upper+((sum_lower<lower)?1:0);
+        top+=upper>>32;
+    }
+
+    // Sets m_wraps of a sum that add_product_unchecked() built from zero.
+    // top/2^32 is below the exact sum/2^128 by less than one 2^32nd per
+    // product, so with fewer than 2^32 products the wraps are that rounded up.
+    FIXED_CONSTEXPR14 void set_wraps(__int64 top)
+    {
+        m_wraps=(top-(m_upper>>32)+0xffffffff)>>32;
+    }
+
+public:
+    FIXED_CONSTEXPR basic_fixed_accumulator():
+        m_lower(0),m_upper(0),m_wraps(0)
+    {}
+
+    FIXED_CONSTEXPR explicit basic_fixed_accumulator(value_type const& initial):
+        m_lower((unsigned __int64)initial.m_nVal<<FracBits),
+        m_upper((__int64)initial.m_nVal>>(63-FracBits)>>1),
+        m_wraps(0)
+    {}
+
+    FIXED_CONSTEXPR14 basic_fixed_accumulator& operator+=(value_type const& val)
+    {
+        add((__int64)val.m_nVal>>(63-FracBits)>>1,(unsigned __int64)val.m_nVal<<FracBits);
+        return *this;
+    }
+    FIXED_CONSTEXPR14 basic_fixed_accumulator& operator-=(value_type const& val)
+    {
+        subtract((__int64)val.m_nVal>>(63-FracBits)>>1,(unsigned __int64)val.m_nVal<<FracBits);
+        return *this;
+    }
+
+    FIXED_CONSTEXPR14 basic_fixed_accumulator& operator+=(basic_fixed_accumulator const& other)
+    {
+        add(other.m_upper,other.m_lower);
+        m_wraps+=other.m_wraps;
+        return *this;
+    }
+    FIXED_CONSTEXPR14 basic_fixed_accumulator& operator-=(basic_fixed_accumulator const& other)
+    {
+        subtract(other.m_upper,other.m_lower);
+        m_wraps-=other.m_wraps;
+        return *this;
+    }
+
+    // multiplies the sum exactly, by a shift where factor is a power of two
+    FIXED_CONSTEXPR14 basic_fixed_accumulator& operator*=(int factor)
+    {
+        unsigned __int64 const magnitude=(factor<0)?0-(unsigned __int64)(__int64)factor:(unsigned __int64)factor;
+        // the product divided by 2^128 and rounded down, from the signed
+        // upper word; the factor 1 leaves just its sign
+        __int64 carried=m_upper>>63;
+        if(!(magnitude&(magnitude-1)))
+        {
+            unsigned shift=0;
+            while(((unsigned __int64)1<<shift)<magnitude)
+            {
+                ++shift;
+            }
+            if(!magnitude)
+            {
+                carried=0;
+                m_upper=0;
+                m_lower=0;
+            }
+            else if(shift)
+            {
+                carried=m_upper>>(64-shift);
+                m_upper=(__int64)(((unsigned __int64)m_upper<<shift)|(m_lower>>(64-shift)));
+                m_lower<<=shift;
+            }
+        }
+        else
+        {
+            // magnitude is below 2^32, so each partial product fits a word
+            unsigned __int64 const lower_part=(m_lower&0xffffffff)*magnitude;
+            unsigned __int64 const upper_part=(m_lower>>32)*magnitude;
+            unsigned __int64 const lower=lower_part+(upper_part<<32);
+            unsigned __int64 const carry=(upper_part>>32)+((lower<lower_part)?1:0);
+            // the same for the signed upper word, whose top half keeps its sign
+            unsigned __int64 const upper_lower_part=((unsigned __int64)m_upper&0xffffffff)*magnitude+carry;
+            __int64 const upper_upper_part=(m_upper>>32)*(__int64)magnitude+(__int64)(upper_lower_part>>32);
+            carried=upper_upper_part>>32;
+            m_upper=(__int64)(((unsigned __int64)upper_upper_part<<32)|(upper_lower_part&0xffffffff));
+            m_lower=lower;
+        }
+        // reading the new upper word as signed takes 2^128 off when its top
+        // bit is set
+        m_wraps=m_wraps*(__int64)magnitude+carried+(m_upper>>63&1);
+        if(factor<0)
+        {
+            // only the most negative 128-bit value has no negation, and
+            // -(-2^127) is 2^128-2^127
+            bool const most_negative=(m_upper==(__int64)0x8000000000000000I64) && !m_lower;
+            m_upper=(__int64)(~(unsigned __int64)m_upper+((m_lower==0)?1:0));
+            m_lower=0-m_lower;
+            m_wraps=(most_negative?1:0)-m_wraps;
+        }
+        return *this;
+    }
+
+    // adds or subtracts a*b exactly
+    FIXED_CONSTEXPR_ARITHMETIC basic_fixed_accumulator& add_product(value_type const& a,value_type const& b)
+    {
+        unsigned __int64 lower=0;
+        __int64 const upper=product(a,b,&lower);
+        add(upper,lower);
+        return *this;
+    }
+    FIXED_CONSTEXPR_ARITHMETIC basic_fixed_accumulator& subtract_product(value_type const& a,value_type const& b)
+    {
+        unsigned __int64 lower=0;
+        __int64 const upper=product(a,b,&lower);
+        subtract(upper,lower);
+        return *this;
+    }
+
+    // adds a[i]*b[i] for each i below count, into two sums so that
+    // consecutive carries need not wait for each other. Looking for a wrap
+    // on every add would triple the cost, so the sums find theirs once per
+    // block from the tops of their products; 32-bit formats cannot wrap
+    // within a block.
+    FIXED_CONSTEXPR_ARITHMETIC basic_fixed_accumulator& add_products(value_type const* a,value_type const* b,std::size_t count)
+    {
+        std::size_t const max_block=(std::size_t)1<<31;
+        bool const can_wrap=fixed_storage_traits<StorageInt>::bits>32;
+        while(count)
+        {
+            std::size_t const block=(count<max_block)?count:max_block;
+            unsigned __int64 even_lower=0;
+            unsigned __int64 even_upper=0;
+            __int64 even_top=0;
+            unsigned __int64 odd_lower=0;
+            unsigned __int64 odd_upper=0;
+            __int64 odd_top=0;
+            std::size_t i=0;
+            for(;i+1<block;i+=2)
+            {
+                add_product_unchecked(a[i],b[i],even_lower,even_upper,even_top);
+                add_product_unchecked(a[i+1],b[i+1],odd_lower,odd_upper,odd_top);
+            }
+            if(i<block)
+            {
+                add_product_unchecked(a[i],b[i],even_lower,even_upper,even_top);
+            }
+            basic_fixed_accumulator even;
+            even.m_lower=even_lower;
+            even.m_upper=(__int64)even_upper;
+            basic_fixed_accumulator odd;
+            odd.m_lower=odd_lower;
+            odd.m_upper=(__int64)odd_upper;
+            if(can_wrap)
+            {
+                even.set_wraps(even_top);
+                odd.set_wraps(odd_top);
+            }
+            *this+=even;
+            *this+=odd;
+            a+=block;
+            b+=block;
+            count-=block;
+        }
+        return *this;
+    }
+
+    FIXED_CONSTEXPR14 value_type result() const
+    {
+        __int64 const limit=fixed_storage_traits<StorageInt>::max_value;
+        if(m_wraps)
+        {
+            return value_type(typename value_type::internal(),(m_wraps<0)?StorageInt(-limit-1):StorageInt(limit));
+        }
+        unsigned __int64 const half=(unsigned __int64)1<<FracBits>>1;
+        unsigned __int64 const lower=m_lower+half;
+        __int64 const upper=(__int64)((unsigned __int64)m_upper+((lower<half)?1:0));
+        __int64 const res=(__int64)((unsigned __int64)upper<<(63-FracBits)<<1|(lower>>FracBits));
+        // the rounded sum fits if the bits above it are copies of its sign
+        if(((upper>>FracBits)!=(res>>63)) || (res>limit) || (res<-limit-1))
+        {
+            return value_type(typename value_type::internal(),(m_upper<0)?StorageInt(-limit-1):StorageInt(limit));
+        }
+        return value_type(typename value_type::internal(),StorageInt(res));
+    }
+};
+
+typedef basic_fixed_accumulator<__int64,fixed_resolution_shift> fixed_accumulator;
+typedef basic_fixed_accumulator<int,16> fixed32_accumulator;
+
+// a*b+c rounded to nearest once, saturating if it does not fit
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR_ARITHMETIC basic_fixed<StorageInt,FracBits> fma(basic_fixed<StorageInt,FracBits> const& a,basic_fixed<StorageInt,FracBits> const& b,basic_fixed<StorageInt,FracBits> const& c)
+{
+    return basic_fixed_accumulator<StorageInt,FracBits>(c).add_product(a,b).result();
+}
+
+// The sum of a[i]*b[i] for i below count, rounded once and saturating if
+// it does not fit
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR_ARITHMETIC basic_fixed<StorageInt,FracBits> dot(basic_fixed<StorageInt,FracBits> const* a,basic_fixed<StorageInt,FracBits> const* b,std::size_t count)
+{
+    return basic_fixed_accumulator<StorageInt,FracBits>().add_products(a,b,count).result();
+}
+
+// The instruction sets the batch functions can use. On x64 all are built
+// in, whatever the compiler targets, and the first batch call picks the
+// best one the processor and operating system support. The environment
+// variable FIXED_BATCH_LEVEL can name a lower level, by its
+// fixed_batch_level_name(), for testing. Elsewhere, or with
+// FIXED_PORTABLE_BATCH, the batch functions are plain loops.
+enum fixed_batch_level
+{
+    fixed_batch_portable,
+    fixed_batch_sse42,
+    fixed_batch_avx2,
+    fixed_batch_avx512
+};
+
+FIXED_INLINE fixed_batch_level fixed_batch_level_in_use();
+// "portable", "sse42", "avx2" or "avx512"
+FIXED_INLINE char const* fixed_batch_level_name(fixed_batch_level level);
+
+// Element-wise operations over arrays of count values, with exactly the
+// results of the scalar operators: res[i]=a[i]*b[i] and so on. res may be
+// one of the inputs. Formats stored in 64 bits use the kernels of
+// fixed_batch_level_in_use(); defined in fixed.cpp.
+template<typename StorageInt,unsigned FracBits>
+void fixed_mul(basic_fixed<StorageInt,FracBits> const* a,basic_fixed<StorageInt,FracBits> const* b,basic_fixed<StorageInt,FracBits>* res,std::size_t count);
+template<typename StorageInt,unsigned FracBits>
+void fixed_add(basic_fixed<StorageInt,FracBits> const* a,basic_fixed<StorageInt,FracBits> const* b,basic_fixed<StorageInt,FracBits>* res,std::size_t count);
+template<typename StorageInt,unsigned FracBits>
+void fixed_sub(basic_fixed<StorageInt,FracBits> const* a,basic_fixed<StorageInt,FracBits> const* b,basic_fixed<StorageInt,FracBits>* res,std::size_t count);
+// res[i]=a[i]*factor
+template<typename StorageInt,unsigned FracBits>
+void fixed_scale(basic_fixed<StorageInt,FracBits> const* a,int factor,basic_fixed<StorageInt,FracBits>* res,std::size_t count);
+template<typename StorageInt,unsigned FracBits>
+void fixed_abs(basic_fixed<StorageInt,FracBits> const* a,basic_fixed<StorageInt,FracBits>* res,std::size_t count);
+template<typename StorageInt,unsigned FracBits>
+void fixed_minimum(basic_fixed<StorageInt,FracBits> const* a,basic_fixed<StorageInt,FracBits> const* b,basic_fixed<StorageInt,FracBits>* res,std::size_t count);
+template<typename StorageInt,unsigned FracBits>
+void fixed_maximum(basic_fixed<StorageInt,FracBits> const* a,basic_fixed<StorageInt,FracBits> const* b,basic_fixed<StorageInt,FracBits>* res,std::size_t count);
+// res[i]=min(max(a[i],lower),upper)
+template<typename StorageInt,unsigned FracBits>
+void fixed_clamp(basic_fixed<StorageInt,FracBits> const* a,basic_fixed<StorageInt,FracBits> const& lower,basic_fixed<StorageInt,FracBits> const& upper,basic_fixed<StorageInt,FracBits>* res,std::size_t count);
+
+// How fixed_convert() rounds to a basic_fixed or an integer. Truncation is
+// what basic_fixed(double) and as_int() do.
+enum fixed_rounding
+{
+    fixed_round_truncate,
+    fixed_round_nearest_even,
+    fixed_round_floor
+};
+
+// Conversions of arrays of count values. Conversions to basic_fixed and to
+// integers saturate values out of range, and take NaN to zero; those to
+// float and double give exactly as_float() and as_double(). They use AVX2
+// where fixed_batch_level_in_use() is fixed_batch_avx2 or above.
+template<typename StorageInt,unsigned FracBits>
+void fixed_convert(int const* in,basic_fixed<StorageInt,FracBits>* out,std::size_t count);
+template<typename StorageInt,unsigned FracBits>
+void fixed_convert(short const* in,basic_fixed<StorageInt,FracBits>* out,std::size_t count);
+template<typename StorageInt,unsigned FracBits>
+void fixed_convert(basic_fixed<StorageInt,FracBits> const* in,int* out,std::size_t count,fixed_rounding mode=fixed_round_truncate);
+template<typename StorageInt,unsigned FracBits>
+void fixed_convert(basic_fixed<StorageInt,FracBits> const* in,short* out,std::size_t count,fixed_rounding mode=fixed_round_truncate);
+#if !defined(FIXED_NO_FLOATING_POINT)
+template<typename StorageInt,unsigned FracBits>
+void fixed_convert(double const* in,basic_fixed<StorageInt,FracBits>* out,std::size_t count,fixed_rounding mode=fixed_round_truncate);
+template<typename StorageInt,unsigned FracBits>
+void fixed_convert(float const* in,basic_fixed<StorageInt,FracBits>* out,std::size_t count,fixed_rounding mode=fixed_round_truncate);
+template<typename StorageInt,unsigned FracBits>
+void fixed_convert(basic_fixed<StorageInt,FracBits> const* in,double* out,std::size_t count);
+template<typename StorageInt,unsigned FracBits>
+void fixed_convert(basic_fixed<StorageInt,FracBits> const* in,float* out,std::size_t count);
+#endif
+
+// Opt-in fused arithmetic. fixed_expr(x) wraps a value so that +, - and *
+// applied to it build an expression tree instead of computing at once;
+// converting the expression to basic_fixed then sums all its terms and
+// products of two values exactly in a basic_fixed_accumulator and rounds
+// once, to nearest. So
+//
+//   fixed r=fixed_expr(a)*b+fixed_expr(c)*d-fixed_expr(e)*f;
+//
+// has one rounding rather than three truncations and two renormalizations.
+// Multiplying by an int scales the exact sum, by a shift for powers of
+// two. Other operands of a product, such as a sum, are evaluated to a value
+// first. Code that does not call fixed_expr() is unaffected.
+
+template<typename StorageInt,unsigned FracBits>
+class fixed_expr_value
+{
+public:
+    typedef basic_fixed<StorageInt,FracBits> value_type;
+
+    FIXED_CONSTEXPR explicit fixed_expr_value(value_type const& val):
+        m_val(val)
+    {}
+
+    FIXED_CONSTEXPR value_type eval() const
+    {
+        return m_val;
+    }
+    FIXED_CONSTEXPR14 void accumulate(basic_fixed_accumulator<StorageInt,FracBits>& sum,bool negate) const
+    {
+        if(negate)
+        {
+            sum-=m_val;
+        }
+        else
+        {
+            sum+=m_val;
+        }
+    }
+
+private:
+    value_type m_val;
+};
+
+template<typename StorageInt,unsigned FracBits>
+class fixed_expr_product
+{
+public:
+    typedef basic_fixed<StorageInt,FracBits> value_type;
+
+    FIXED_CONSTEXPR fixed_expr_product(value_type const& lhs,value_type const& rhs):
+        m_lhs(lhs),m_rhs(rhs)
+    {}
+
+    FIXED_CONSTEXPR_ARITHMETIC value_type eval() const
+    {
+        return basic_fixed_accumulator<StorageInt,FracBits>().add_product(m_lhs,m_rhs).result();
+    }
+    FIXED_CONSTEXPR_ARITHMETIC void accumulate(basic_fixed_accumulator<StorageInt,FracBits>& sum,bool negate) const
+    {
+        if(negate)
+        {
+            sum.subtract_product(m_lhs,m_rhs);
+        }
+        else
+        {
+            sum.add_product(m_lhs,m_rhs);
+        }
+    }
+
+private:
+    value_type m_lhs;
+    value_type m_rhs;
+};
+
+template<typename Lhs,typename Rhs,bool Subtract>
+class fixed_expr_sum
+{
+public:
+    typedef typename Lhs::value_type value_type;
+
+    FIXED_CONSTEXPR fixed_expr_sum(Lhs const& lhs,Rhs const& rhs):
+        m_lhs(lhs),m_rhs(rhs)
+    {}
+
+    FIXED_CONSTEXPR_ARITHMETIC value_type eval() const
+    {
+        basic_fixed_accumulator<typename value_type::storage_type,value_type::resolution_shift> sum;
+        accumulate(sum,false);
+        return sum.result();
+    }
+    FIXED_CONSTEXPR_ARITHMETIC void accumulate(basic_fixed_accumulator<typename value_type::storage_type,value_type::resolution_shift>& sum,bool negate) const
+    {
+        m_lhs.accumulate(sum,negate);
+        m_rhs.accumulate(sum,negate!=Subtract);
+    }
+
+private:
+    Lhs m_lhs;
+    Rhs m_rhs;
+};
+
+template<typename Node>
+class fixed_expr_scaled
+{
+public:
+    typedef typename Node::value_type value_type;
+
+    FIXED_CONSTEXPR fixed_expr_scaled(Node const& node,int factor):
+        m_node(node),m_factor(factor)
+    {}
+
+    FIXED_CONSTEXPR_ARITHMETIC value_type eval() const
+    {
+        basic_fixed_accumulator<typename value_type::storage_type,value_type::resolution_shift> sum;
+        accumulate(sum,false);
+        return sum.result();
+    }
+    FIXED_CONSTEXPR_ARITHMETIC void accumulate(basic_fixed_accumulator<typename value_type::storage_type,value_type::resolution_shift>& sum,bool negate) const
+    {
+        basic_fixed_accumulator<typename value_type::storage_type,value_type::resolution_shift> part;
+        m_node.accumulate(part,negate);
+        sum+=(part*=m_factor);
+    }
+
+private:
+    Node m_node;
+    int m_factor;
+};
+
+template<typename Node>
+class fixed_expr_negate
+{
+public:
+    typedef typename Node::value_type value_type;
+
+    FIXED_CONSTEXPR explicit fixed_expr_negate(Node const& node):
+        m_node(node)
+    {}
+
+    FIXED_CONSTEXPR_ARITHMETIC value_type eval() const
+    {
+        basic_fixed_accumulator<typename value_type::storage_type,value_type::resolution_shift> sum;
+        accumulate(sum,false);
+        return sum.result();
+    }
+    FIXED_CONSTEXPR_ARITHMETIC void accumulate(basic_fixed_accumulator<typename value_type::storage_type,value_type::resolution_shift>& sum,bool negate) const
+    {
+        m_node.accumulate(sum,!negate);
+    }
+
+private:
+    Node m_node;
+};
+
+// An expression built from fixed_expr(), converting implicitly to its value
+template<typename Node>
+class fixed_expression
+{
+public:
+    typedef typename Node::value_type value_type;
+
+    FIXED_CONSTEXPR explicit fixed_expression(Node const& node):
+        m_node(node)
+    {}
+
+    FIXED_CONSTEXPR Node const& node() const
+    {
+        return m_node;
+    }
+    FIXED_CONSTEXPR_ARITHMETIC value_type eval() const
+    {
+        return m_node.eval();
+    }
+    FIXED_CONSTEXPR_ARITHMETIC operator value_type() const
+    {
+        return m_node.eval();
+    }
+
+private:
+    Node m_node;
+};
+
+// Integer types an expression can be scaled by; others, such as double,
+// must be converted to a value explicitly rather than truncated
+template<typename Scalar,typename Node>
+struct fixed_expr_scalar
+{};
+
+template<typename Node>
+struct fixed_expr_scalar<int,Node>
+{
+    typedef fixed_expression<fixed_expr_scaled<Node> > result;
+};
+
+template<typename Node>
+struct fixed_expr_scalar<short,Node>
+{
+    typedef fixed_expression<fixed_expr_scaled<Node> > result;
+};
+
+template<typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR fixed_expression<fixed_expr_value<StorageInt,FracBits> > fixed_expr(basic_fixed<StorageInt,FracBits> const& val)
+{
+    return fixed_expression<fixed_expr_value<StorageInt,FracBits> >(fixed_expr_value<StorageInt,FracBits>(val));
+}
+
+template<typename Lhs,typename Rhs>
+inline FIXED_CONSTEXPR fixed_expression<fixed_expr_sum<Lhs,Rhs,false> > operator+(fixed_expression<Lhs> const& lhs,fixed_expression<Rhs> const& rhs)
+{
+    return fixed_expression<fixed_expr_sum<Lhs,Rhs,false> >(fixed_expr_sum<Lhs,Rhs,false>(lhs.node(),rhs.node()));
+}
+template<typename Lhs,typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR fixed_expression<fixed_expr_sum<Lhs,fixed_expr_value<StorageInt,FracBits>,false> > operator+(fixed_expression<Lhs> const& lhs,basic_fixed<StorageInt,FracBits> const& rhs)
+{
+    return lhs+fixed_expr(rhs);
+}
+template<typename Rhs,typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR fixed_expression<fixed_expr_sum<fixed_expr_value<StorageInt,FracBits>,Rhs,false> > operator+(basic_fixed<StorageInt,FracBits> const& lhs,fixed_expression<Rhs> const& rhs)
+{
+    return fixed_expr(lhs)+rhs;
+}
+
+template<typename Lhs,typename Rhs>
+inline FIXED_CONSTEXPR fixed_expression<fixed_expr_sum<Lhs,Rhs,true> > operator-(fixed_expression<Lhs> const& lhs,fixed_expression<Rhs> const& rhs)
+{
+    return fixed_expression<fixed_expr_sum<Lhs,Rhs,true> >(fixed_expr_sum<Lhs,Rhs,true>(lhs.node(),rhs.node()));
+}
+template<typename Lhs,typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR fixed_expression<fixed_expr_sum<Lhs,fixed_expr_value<StorageInt,FracBits>,true> > operator-(fixed_expression<Lhs> const& lhs,basic_fixed<StorageInt,FracBits> const& rhs)
+{
+    return lhs-fixed_expr(rhs);
+}
+template<typename Rhs,typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR fixed_expression<fixed_expr_sum<fixed_expr_value<StorageInt,FracBits>,Rhs,true> > operator-(basic_fixed<StorageInt,FracBits> const& lhs,fixed_expression<Rhs> const& rhs)
+{
+    return fixed_expr(lhs)-rhs;
+}
+
+template<typename Node>
+inline FIXED_CONSTEXPR fixed_expression<fixed_expr_negate<Node> > operator-(fixed_expression<Node> const& val)
+{
+    return fixed_expression<fixed_expr_negate<Node> >(fixed_expr_negate<Node>(val.node()));
+}
+
+template<typename Lhs,typename Rhs>
+inline FIXED_CONSTEXPR_ARITHMETIC fixed_expression<fixed_expr_product<typename Lhs::value_type::storage_type,Lhs::value_type::resolution_shift> > operator*(fixed_expression<Lhs> const& lhs,fixed_expression<Rhs> const& rhs)
+{
+    typedef fixed_expr_product<typename Lhs::value_type::storage_type,Lhs::value_type::resolution_shift> product;
+    return fixed_expression<product>(product(lhs.eval(),rhs.eval()));
+}
+template<typename Lhs,typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR_ARITHMETIC fixed_expression<fixed_expr_product<StorageInt,FracBits> > operator*(fixed_expression<Lhs> const& lhs,basic_fixed<StorageInt,FracBits> const& rhs)
+{
+    return fixed_expression<fixed_expr_product<StorageInt,FracBits> >(fixed_expr_product<StorageInt,FracBits>(lhs.eval(),rhs));
+}
+template<typename Rhs,typename StorageInt,unsigned FracBits>
+inline FIXED_CONSTEXPR_ARITHMETIC fixed_expression<fixed_expr_product<StorageInt,FracBits> > operator*(basic_fixed<StorageInt,FracBits> const& lhs,fixed_expression<Rhs> const& rhs)
+{
+    return fixed_expression<fixed_expr_product<StorageInt,FracBits> >(fixed_expr_product<StorageInt,FracBits>(lhs,rhs.eval()));
+}
+template<typename Node,typename Scalar>
+inline FIXED_CONSTEXPR typename fixed_expr_scalar<Scalar,Node>::result operator*(fixed_expression<Node> const& lhs,Scalar rhs)
+{
+    return fixed_expression<fixed_expr_scaled<Node> >(fixed_expr_scaled<Node>(lhs.node(),rhs));
+}
+template<typename Node,typename Scalar>
+inline FIXED_CONSTEXPR typename fixed_expr_scalar<Scalar,Node>::result operator*(Scalar lhs,fixed_expression<Node> const& rhs)
+{
+    return fixed_expression<fixed_expr_scaled<Node> >(fixed_expr_scaled<Node>(rhs.node(),lhs));
+}
+
+FIXED_CONSTEXPR fixed const fixed_max(fixed::internal(),0x7fffffffffffffffI64);
+FIXED_CONSTEXPR fixed const fixed_one(fixed::internal(),1I64<<(fixed_resolution_shift));
+FIXED_CONSTEXPR fixed const fixed_zero(fixed::internal(),0);
+FIXED_CONSTEXPR fixed const fixed_half(fixed::internal(),1I64<<(fixed_resolution_shift-1));
+FIXED_CONSTEXPR fixed const fixed_pi(fixed::internal(),fixed_constants<__int64,fixed_resolution_shift>::internal_pi);
+FIXED_CONSTEXPR fixed const fixed_two_pi(fixed::internal(),fixed_constants<__int64,fixed_resolution_shift>::internal_two_pi);
+FIXED_CONSTEXPR fixed const fixed_half_pi(fixed::internal(),fixed_constants<__int64,fixed_resolution_shift>::internal_half_pi);
+FIXED_CONSTEXPR fixed const fixed_quarter_pi(fixed::internal(),fixed_constants<__int64,fixed_resolution_shift>::internal_quarter_pi);
+
+#if defined(FIXED_HEADER_ONLY)
+#include "fixed.cpp"
+#endif
+
+#endif